@@ -1,64 +1,160 @@
+#include <algorithm>
 #include <chrono>
+#include <functional>
 #include <iostream>
+#include <thread>
 #include <vector>
 #include <random>
+#include <cstdlib>
 #include <unistd.h>
 #include "moveGenerator.hpp"
+#include "playout.hpp"
+#include "random.hpp"
 
+// results of single benchmark thread, aligned to avoid false sharing
+struct alignas(64) threadStats
+{
+    playoutStats stats;
+    double seconds = 0;
+};
 
-int main(int argc, char *argv[])
+struct benchmarkConfig
 {
     int games = 100000;
-    int opt;
-    while ((opt = getopt(argc, argv, "n:")) != -1)
+    int threads = 1;
+    uint64_t seed = 0;
+    bool removeDuplicates = true;
+    int batch = 0;  // 0 - one game at a time
+};
+
+void playGames(int games, const benchmarkConfig& config, Xoshiro256& numberGenerator, threadStats& result)
+{
+    threadStats local;
+    auto start = std::chrono::steady_clock::now();
+    if (config.batch > 0)
     {
-        if (opt == 'n')
+        BatchPlayout engine(config.batch, numberGenerator);
+        engine.setRemoveDuplicates(config.removeDuplicates);
+        local.stats = engine.run(games);
+    }
+    else
+    {
+        CheckersMoveGenerator moveGenerator;
+        moveGenerator.setRemoveDuplicates(config.removeDuplicates);
+        for (int i = 0; i < games; ++i)
         {
-            games = atoi(optarg);
+            local.stats.add(playout(moveGenerator, numberGenerator, local.stats.rounds));
+            moveGenerator.resetState();
         }
     }
-    std::cout << "benchmark with " << games << " random games started...\n";
-    CheckersMoveGenerator moveGenerator;
-    long long rounds = 0;
-    std::random_device device;
-    std::mt19937 numberGenerator(device());
+    auto end = std::chrono::steady_clock::now();
+    local.seconds = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000000.0;
+    result = local;
+}
+
+// plays games on threads and prints results, returns moves/s
+double runBenchmark(const benchmarkConfig& config)
+{
+    int games = config.games;
+    int threads = config.threads;
+    std::cout << "benchmark with " << games << " random games on " << threads << " threads started...\n";
+    std::cout << "seed: " << config.seed << ", board: " << CheckersMoveGenerator::boardName()
+              << ", remove duplicates: " << (config.removeDuplicates ? "yes" : "no");
+    if (config.batch > 0)
+        std::cout << ", batch: " << config.batch << " (" << BitboardBatch::getBackend() << ")";
+    std::cout << std::endl;
+    // each thread gets non-overlapping stream of the same seeded generator
+    std::vector<Xoshiro256> numberGenerators;
+    Xoshiro256 numberGenerator(config.seed);
+    for (int id = 0; id < threads; ++id)
+    {
+        numberGenerators.push_back(numberGenerator);
+        numberGenerator.jump();
+    }
+    std::vector<threadStats> results(threads);
     auto start = std::chrono::steady_clock::now();
-    int whiteWins = 0, blackWins = 0, draws = 0;
-    for (int i = 0; i < games; ++i) 
+    std::vector<std::thread> pool;
+    for (int id = 0; id < threads; ++id)
     {
-        while(1)
-        {
-            if (moveGenerator.isDraw())
-            {
-                draws++;
-                break;
-            }
-            auto moves = moveGenerator.getMovesList();
-            int n = moves.size();
-            if (n == 0)
-            {
-                if (moveGenerator.isDraw())
-                    draws++;
-                else if (moveGenerator.whiteTurn)
-                    whiteWins++;
-                else
-                    blackWins++;
-                break;
-            }
-            std::uniform_int_distribution<int> distribution(0,n-1);
-            auto mv = moves[distribution(numberGenerator)];
-            moveGenerator.applyMove(mv);
-            rounds++;
-        }
-        moveGenerator.resetState();
+        int threadGames = games / threads + (id < games % threads ? 1 : 0);
+        pool.emplace_back(playGames, threadGames, std::cref(config), std::ref(numberGenerators[id]), std::ref(results[id]));
+    }
+    for (auto& thread : pool)
+    {
+        thread.join();
     }
     auto end = std::chrono::steady_clock::now();
     double seconds = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000000.0;
+
+    playoutStats total;
+    for (const auto& result : results)
+    {
+        total.merge(result.stats);
+    }
+    if (threads > 1)
+    {
+        for (int id = 0; id < threads; ++id)
+        {
+            const auto& result = results[id];
+            std::cout << "thread " << id << ": games/s: " << result.stats.games / result.seconds
+                      << " moves/s: " << result.stats.rounds / result.seconds << std::endl;
+        }
+    }
     std::cout << "time: " << seconds << "s" << std::endl;
-    std::cout << "moves: " << rounds << std::endl;
+    std::cout << "moves: " << total.rounds << std::endl;
     std::cout << "games/s: " << games / seconds << std::endl;
-    std::cout << "moves/s: " << rounds / seconds << std::endl;
-    std::cout << "white/black win ratio " << whiteWins * 1.0 / blackWins << std::endl;
-    std::cout << "draws/games ratio " << draws * 1.0 / games << std::endl;
+    std::cout << "moves/s: " << total.rounds / seconds << std::endl;
+    std::cout << "white/black win ratio " << total.whiteWins * 1.0 / total.blackWins << std::endl;
+    std::cout << "draws/games ratio " << total.draws * 1.0 / games << std::endl;
+    return total.rounds / seconds;
+}
+
+int main(int argc, char *argv[])
+{
+    benchmarkConfig config;
+    config.seed = std::random_device()();
+    bool compare = false;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:t:s:b:kc")) != -1)
+    {
+        if (opt == 'n')
+        {
+            config.games = atoi(optarg);
+        }
+        else if (opt == 't')
+        {
+            config.threads = std::max(1, atoi(optarg));
+        }
+        else if (opt == 's')
+        {
+            config.seed = strtoull(optarg, nullptr, 10);
+        }
+        else if (opt == 'b')
+        {
+            config.batch = std::max(0, atoi(optarg));
+        }
+        else if (opt == 'k')
+        {
+            config.removeDuplicates = false;
+        }
+        else if (opt == 'c')
+        {
+            compare = true;
+        }
+    }
+    if (compare)
+    {
+        config.removeDuplicates = false;
+        double withDuplicates = runBenchmark(config);
+        std::cout << std::endl;
+        config.removeDuplicates = true;
+        double withoutDuplicates = runBenchmark(config);
+        std::cout << std::endl << "duplicate removal cost: "
+                  << 100.0 * (withDuplicates / withoutDuplicates - 1) << "% of moves/s" << std::endl;
+    }
+    else
+    {
+        runBenchmark(config);
+    }
     return 0;
-}
\ No newline at end of file
+}
@@ -1,5 +1,86 @@
 #include "bitboard.hpp"
 
+namespace
+{
+// single capture sequence step: position of the jumping piece, board state
+// after captures so far and xor of all squares touched by the sequence
+struct jumpStep
+{
+    uint32_t square;
+    uint32_t pieces;
+    uint32_t empty;
+    uint32_t path;
+    uint8_t dir;
+    bool last;
+};
+
+// mask repeated in white (low) and black (high) half of packed word
+constexpr uint64_t bothSides(uint32_t mask)
+{
+    return mask | static_cast<uint64_t>(mask) << 32;
+}
+
+// one sequence can't capture more than 12 pieces
+constexpr int maxJumpDepth = 16;
+
+// output for jump walk which only counts finished sequences
+struct moveCounter
+{
+    int count = 0;
+    void push_back(const uint32_t&) { count++; }
+};
+
+// depth-first walk over all capture sequences of jumpers in directions
+// [firstDir, lastDir) using explicit stack, men keep captured pieces as
+// enemies, kings remove them and free their start square
+template <int firstDir, int lastDir, bool king, typename Output>
+inline void walkJumps(uint32_t jumpers, uint32_t pieces, uint32_t empty, Output& jumps)
+{
+    jumpStep stack[maxJumpDepth];
+    while (jumpers)
+    {
+        int depth = 0;
+        stack[0] = { lsb(jumpers), pieces, empty, 0, firstDir, false };
+        while (depth >= 0)
+        {
+            jumpStep& step = stack[depth];
+            const squareNeighbours& neighbours = squareTable[lsbIndex(step.square)];
+            bool found = false;
+            while (step.dir < lastDir)
+            {
+                int dir = step.dir++;
+                uint32_t captured = neighbours.step[dir] & step.pieces;
+                uint32_t landing = neighbours.jump[dir] & step.empty;
+                if (captured && landing)
+                {
+                    jumpStep& next = stack[depth + 1];
+                    next.square = landing;
+                    next.pieces = king ? step.pieces ^ captured : step.pieces;
+                    next.empty = king ? step.empty ^ step.square : step.empty ^ captured;
+                    next.path = step.path ^ step.square ^ landing ^ captured;
+                    next.dir = firstDir;
+                    next.last = true;
+                    step.last = false;
+                    found = true;
+                    break;
+                }
+            }
+            if (found)
+            {
+                depth++;
+            }
+            else
+            {
+                if (step.last)
+                    jumps.push_back(step.path);
+                depth--;
+            }
+        }
+        jumpers = clearLsb(jumpers);
+    }
+}
+}
+
 void CheckersBitboard::resetBoard()
 {
     BlackPieces = 0xFFF00000;
@@ -39,85 +120,258 @@ uint32_t CheckersBitboard::getKings() const
     return Kings;
 }
 
+template <Color color>
+uint32_t CheckersBitboard::getMovers() const
+{
+    using side = ColorTraits<color>;
+    uint32_t pieces = getPieces<color>();
+    if constexpr (side::forwardUp)
+        return getMoversUp(pieces) | getMoversDown(pieces & Kings);
+    else
+        return getMoversDown(pieces) | getMoversUp(pieces & Kings);
+}
+
+template <Color color>
+uint32_t CheckersBitboard::getJumpers() const
+{
+    using side = ColorTraits<color>;
+    uint32_t pieces = getPieces<color>();
+    uint32_t enemy = getPieces<side::opponent>();
+    if constexpr (side::forwardUp)
+        return getJumpersUp(pieces, enemy) | getJumpersDown(pieces & Kings, enemy);
+    else
+        return getJumpersDown(pieces, enemy) | getJumpersUp(pieces & Kings, enemy);
+}
+
+template <Color color>
+void CheckersBitboard::getMoveList(MoveList& moves) const
+{
+    using side = ColorTraits<color>;
+    auto movers = getMovers<color>();
+    if constexpr (side::forwardUp)
+    {
+        getMoveListUp(movers, moves);
+        getMoveListDown(movers & Kings, moves);
+    }
+    else
+    {
+        getMoveListDown(movers, moves);
+        getMoveListUp(movers & Kings, moves);
+    }
+}
+
+template <Color color, typename Output>
+void CheckersBitboard::getJumps(uint32_t jumpers, Output& jumps) const
+{
+    using side = ColorTraits<color>;
+    uint32_t enemy = getPieces<side::opponent>();
+    uint32_t empty = ~(WhitePieces | BlackPieces);
+    if constexpr (side::forwardUp)
+        getJumpListUp(jumpers & ~Kings, enemy, empty, jumps);
+    else
+        getJumpListDown(jumpers & ~Kings, enemy, empty, jumps);
+    getJumpListTwoSides(jumpers & Kings, enemy, empty, jumps);
+}
+
+template <Color color>
+void CheckersBitboard::getJumpList(uint32_t jumpers, MoveList& jumps) const
+{
+    getJumps<color>(jumpers, jumps);
+}
+
+template <Color color>
+int CheckersBitboard::countMoves() const
+{
+    auto jumpers = getJumpers<color>();
+    if (jumpers)
+    {
+        moveCounter jumps;
+        getJumps<color>(jumpers, jumps);
+        return jumps.count;
+    }
+    return countQuietMoves<color>();
+}
+
+template <Color color>
+int CheckersBitboard::countQuietMoves() const
+{
+    uint32_t pieces = getPieces<color>();
+    if constexpr (ColorTraits<color>::forwardUp)
+        return countMovesUp(pieces) + countMovesDown(pieces & Kings);
+    else
+        return countMovesDown(pieces) + countMovesUp(pieces & Kings);
+}
+
+template <Color color>
+uint32_t CheckersBitboard::getQuietMove(int index) const
+{
+    uint32_t pieces = getPieces<color>();
+    uint32_t up = ColorTraits<color>::forwardUp ? pieces : pieces & Kings;
+    uint32_t down = ColorTraits<color>::forwardUp ? pieces & Kings : pieces;
+    uint32_t empty = ~(WhitePieces | BlackPieces);
+    // pieces stepping by each shift, same groups as countMovesUp/countMovesDown
+    const uint32_t movers[6] = {
+        (empty >> 4) & up, ((empty & 0x70707070) >> 3) & up, ((empty & 0x0E0E0E00) >> 5) & up,
+        (empty << 4) & down, ((empty & 0x0E0E0E0E) << 3) & down, ((empty & 0x00707070) << 5) & down };
+    constexpr int shifts[6] = {4, 3, 5, 4, 3, 5};
+    for (int group = 0; group < 6; ++group)
+    {
+        int count = popcount(movers[group]);
+        if (index < count)
+        {
+            uint32_t piece = nthBit(movers[group], index);
+            return piece | (group < 3 ? piece << shifts[group] : piece >> shifts[group]);
+        }
+        index -= count;
+    }
+    return 0;
+}
+
+template <Color color>
+void CheckersBitboard::applyMove(const uint32_t& mv)
+{
+    using side = ColorTraits<color>;
+    uint32_t& pieces = piecesOf<color>();
+    uint32_t& enemy = piecesOf<side::opponent>();
+    bool king = mv & pieces & Kings;  // captured kings don't crown capturing man
+    pieces ^= mv & ~enemy;  // move piece
+    enemy &= ~mv;  // remove captured pieces
+    if (king)
+        Kings ^= mv & pieces;  // move king if piece=king
+    Kings |= mv & pieces & side::promotion;  // promote
+    Kings &= WhitePieces | BlackPieces;  // remove captured kings
+}
+
+template <Color color>
+void CheckersBitboard::undoMove(const uint32_t& mv, uint32_t captured, uint32_t kings)
+{
+    using side = ColorTraits<color>;
+    piecesOf<color>() ^= mv & ~captured;
+    piecesOf<side::opponent>() |= captured;
+    Kings ^= kings;
+}
+
+// white men move up and black men down, so white pieces and black kings
+// share up shifts, black pieces and white kings share down shifts
+// masks keep shifted bits from crossing to the other half
+uint64_t CheckersBitboard::getBothMovers() const
+{
+    uint64_t empty = bothSides(~(WhitePieces | BlackPieces));
+    uint64_t up = WhitePieces | static_cast<uint64_t>(BlackPieces & Kings) << 32;
+    uint64_t down = (WhitePieces & Kings) | static_cast<uint64_t>(BlackPieces) << 32;
+    uint64_t movers = ((empty & bothSides(0xFFFFFFF0)) >> 4) & up;
+    movers |= ((empty & bothSides(0x70707070)) >> 3) & up;
+    movers |= ((empty & bothSides(0x0E0E0E00)) >> 5) & up;
+    movers |= ((empty & bothSides(0x0FFFFFFF)) << 4) & down;
+    movers |= ((empty & bothSides(0x0E0E0E0E)) << 3) & down;
+    movers |= ((empty & bothSides(0x00707070)) << 5) & down;
+    return movers;
+}
+
+// jumper masks already keep landing squares inside of own half
+uint64_t CheckersBitboard::getBothJumpers() const
+{
+    uint64_t empty = bothSides(~(WhitePieces | BlackPieces));
+    uint64_t enemy = BlackPieces | static_cast<uint64_t>(WhitePieces) << 32;
+    uint64_t up = WhitePieces | static_cast<uint64_t>(BlackPieces & Kings) << 32;
+    uint64_t down = (WhitePieces & Kings) | static_cast<uint64_t>(BlackPieces) << 32;
+    uint64_t jumps = up & bothSides(0x00070707) & (empty >> 9) & (enemy >> 4);
+    jumps |= up & bothSides(0x000E0E0E) & (empty >> 7) & (enemy >> 3);
+    jumps |= up & bothSides(0x00707070) & (empty >> 9) & (enemy >> 5);
+    jumps |= up & bothSides(0x00E0E0E0) & (empty >> 7) & (enemy >> 4);
+    jumps |= down & bothSides(0x07070700) & (empty << 7) & (enemy << 4);
+    jumps |= down & bothSides(0x0E0E0E00) & (empty << 9) & (enemy << 5);
+    jumps |= down & bothSides(0x70707000) & (empty << 7) & (enemy << 3);
+    jumps |= down & bothSides(0xE0E0E000) & (empty << 9) & (enemy << 4);
+    return jumps;
+}
+
 uint32_t CheckersBitboard::getWhiteMovers() const
 {
-    return getMoversUp(WhitePieces) | getMoversDown(WhitePieces & Kings);
+    return getMovers<Color::White>();
 }
 
 uint32_t CheckersBitboard::getBlackMovers() const
 {
-    return getMoversDown(BlackPieces) | getMoversUp(BlackPieces & Kings);
+    return getMovers<Color::Black>();
 }
 
 uint32_t CheckersBitboard::getWhiteJumpers() const
 {
-    return getJumpersUp(WhitePieces, BlackPieces) | getJumpersDown(WhitePieces & Kings, BlackPieces);
+    return getJumpers<Color::White>();
 }
 
 uint32_t CheckersBitboard::getBlackJumpers() const
 {
-    return getJumpersDown(BlackPieces, WhitePieces) | getJumpersUp(BlackPieces & Kings, WhitePieces);
+    return getJumpers<Color::Black>();
 }
 
 std::vector<uint32_t> CheckersBitboard::getWhiteMoveList() const
 {
-    std::vector<uint32_t> moves;
-    moves.reserve(32);
-    auto movers = getWhiteMovers();
-    getMoveListUp(movers, moves);
-    getMoveListDown(movers & Kings, moves);
-    return moves;
+    MoveList moves;
+    getMoveList<Color::White>(moves);
+    return moves.toVector();
 }
 
 std::vector<uint32_t> CheckersBitboard::getBlackMoveList() const
 {
-    std::vector<uint32_t> moves;
-    moves.reserve(32);
-    auto movers = getBlackMovers();
-    getMoveListDown(movers, moves);
-    getMoveListUp(movers & Kings, moves);
-    return moves;
+    MoveList moves;
+    getMoveList<Color::Black>(moves);
+    return moves.toVector();
 }
 
 std::vector<uint32_t> CheckersBitboard::getWhiteJumpList(uint32_t jumpers) const
 {
-    std::vector<uint32_t> jumps;
-    jumps.reserve(32);
-    uint32_t empty = ~(WhitePieces | BlackPieces);
-    getJumpListUp(jumpers & ~Kings, BlackPieces, empty, jumps);
-    getJumpListTwoSides(jumpers & Kings, BlackPieces, empty, jumps);
-    return jumps;
+    MoveList jumps;
+    getJumpList<Color::White>(jumpers, jumps);
+    return jumps.toVector();
 }
 
 std::vector<uint32_t> CheckersBitboard::getBlackJumpList(uint32_t jumpers) const
 {
-    std::vector<uint32_t> jumps;
-    jumps.reserve(32);
-    uint32_t empty = ~(WhitePieces | BlackPieces);
-    getJumpListDown(jumpers & ~Kings, WhitePieces, empty, jumps);
-    getJumpListTwoSides(jumpers & Kings, WhitePieces, empty, jumps);
-    return jumps;
+    MoveList jumps;
+    getJumpList<Color::Black>(jumpers, jumps);
+    return jumps.toVector();
+}
+
+void CheckersBitboard::getWhiteMoveList(MoveList& moves) const
+{
+    getMoveList<Color::White>(moves);
+}
+
+void CheckersBitboard::getBlackMoveList(MoveList& moves) const
+{
+    getMoveList<Color::Black>(moves);
+}
+
+void CheckersBitboard::getWhiteJumpList(uint32_t jumpers, MoveList& jumps) const
+{
+    getJumpList<Color::White>(jumpers, jumps);
+}
+
+void CheckersBitboard::getBlackJumpList(uint32_t jumpers, MoveList& jumps) const
+{
+    getJumpList<Color::Black>(jumpers, jumps);
+}
+
+int CheckersBitboard::countWhiteMoves() const
+{
+    return countMoves<Color::White>();
+}
+
+int CheckersBitboard::countBlackMoves() const
+{
+    return countMoves<Color::Black>();
 }
 
 void CheckersBitboard::applyWhiteMove(const uint32_t& mv)
 {
-    WhitePieces ^= mv & ~BlackPieces;  // move white piece
-    BlackPieces &= ~mv;  // remove black pieces
-    if (mv & Kings)
-        Kings ^= mv & WhitePieces;  // move king if piece=king
-    Kings |= mv & WhitePieces & 0xF0000000;  // promote white
-    Kings &= BlackPieces | WhitePieces;  // remove black kings (if white jumps over king)
+    applyMove<Color::White>(mv);
 }
 
 void CheckersBitboard::applyBlackMove(const uint32_t& mv)
 {
-    BlackPieces ^= mv & ~WhitePieces;
-    WhitePieces &= ~mv;
-    if (mv & Kings)
-        Kings ^= mv & BlackPieces;
-    Kings |= mv & BlackPieces & 0xF;
-    Kings &= WhitePieces | BlackPieces;
-
+    applyMove<Color::Black>(mv);
 }
 
 inline uint32_t CheckersBitboard::getMoversDown(const uint32_t& pieces) const
@@ -162,198 +416,90 @@ inline uint32_t CheckersBitboard::getJumpersUp(const uint32_t& jumpers, const ui
     return jumps;
 }
 
-inline void CheckersBitboard::getMoveListDown(uint32_t pieces, std::vector<uint32_t>& moves) const
+inline void CheckersBitboard::getMoveListDown(uint32_t pieces, MoveList& moves) const
 {
     uint32_t empty = ~(WhitePieces | BlackPieces);
     while(pieces)
     {
-        uint32_t piece = msb(pieces);
-        uint32_t mv = (empty << 4) & piece;
-        if (mv)
-            moves.push_back(piece | (piece >> 4));
-        
-        mv = ((empty & 0x0E0E0E0E) << 3) & piece;
-        if (mv)
-            moves.push_back(piece | (piece >> 3));
-        
-        mv = ((empty & 0x00707070) << 5) & piece;
-        if (mv)
-            moves.push_back(piece | (piece >> 5));
-        
+        uint32_t piece = lsb(pieces);
+        const squareNeighbours& neighbours = squareTable[lsbIndex(piece)];
+        if (neighbours.step[DownLeft] & empty)
+            moves.push_back(piece | neighbours.step[DownLeft]);
+        if (neighbours.step[DownRight] & empty)
+            moves.push_back(piece | neighbours.step[DownRight]);
         pieces ^= piece;
     }
 }
 
-inline void CheckersBitboard::getMoveListUp(uint32_t pieces, std::vector<uint32_t>& moves) const
+inline void CheckersBitboard::getMoveListUp(uint32_t pieces, MoveList& moves) const
 {
     uint32_t empty = ~(WhitePieces | BlackPieces);
     while(pieces)
     {
-        uint32_t piece = msb(pieces);
-        uint32_t mv = (empty >> 4) & piece;
-        if (mv)
-            moves.push_back(piece | (piece << 4));
-        
-        mv = ((empty & 0x70707070) >> 3) & piece;
-        if (mv)
-            moves.push_back(piece | (piece << 3));
-        
-        mv = ((empty & 0x0E0E0E00) >> 5) & piece;
-        if (mv)
-            moves.push_back(piece | (piece << 5));
-        
+        uint32_t piece = lsb(pieces);
+        const squareNeighbours& neighbours = squareTable[lsbIndex(piece)];
+        if (neighbours.step[UpLeft] & empty)
+            moves.push_back(piece | neighbours.step[UpLeft]);
+        if (neighbours.step[UpRight] & empty)
+            moves.push_back(piece | neighbours.step[UpRight]);
         pieces ^= piece;
     }
 }
 
-void CheckersBitboard::getJumpListDown(uint32_t jumpers, uint32_t pieces, uint32_t empty, std::vector<uint32_t>& jumps) const
+// counts moves in each direction without generating them
+inline int CheckersBitboard::countMovesDown(uint32_t pieces) const
 {
-    static constexpr jumpMask bits[4] = {
-        {0x70707000, 7, 3}, // even rows
-        {0xE0E0E000, 9, 4}, // even rows
-        {0x07070700, 7, 4}, // odd rows
-        {0x0E0E0E00, 9, 5}  // odd rows
-    };
-    while(jumpers)
-    {
-        uint32_t jumper = msb(jumpers);
-        int offset = (jumper & 0x0F0F0F00) ? 2 : 0;  // offset for odd rows
-        for (int i = offset; i < 2 + offset; ++i)
-        {
-            bool isJump = bits[i].mask & (empty << bits[i].empty) & (pieces << bits[i].enemy) & jumper;
-            if (isJump)
-            {
-                uint32_t jump = jumper | (jumper >> bits[i].empty) | (jumper >> bits[i].enemy);
-                std::vector<uint32_t> nextJumps;
-                nextJumps.reserve(4);
-                getJumpListDown(jumper >> bits[i].empty, pieces, empty ^ (jumper >> bits[i].enemy), nextJumps);
-                if (!nextJumps.empty())
-                {
-                    for (const auto& next : nextJumps)
-                    {
-                        jumps.push_back(jump ^ next);
-                    }
-                }
-                else
-                {
-                    jumps.push_back(jump);
-                }
-            }
-        }
-        jumpers ^= jumper;
-    }
+    if (pieces == 0)
+        return 0;
+    uint32_t empty = ~(WhitePieces | BlackPieces);
+    return popcount((empty << 4) & pieces)
+         + popcount(((empty & 0x0E0E0E0E) << 3) & pieces)
+         + popcount(((empty & 0x00707070) << 5) & pieces);
 }
 
-void CheckersBitboard::getJumpListUp(uint32_t jumpers, uint32_t pieces, uint32_t empty, std::vector<uint32_t>& jumps) const
+inline int CheckersBitboard::countMovesUp(uint32_t pieces) const
 {
-    static constexpr jumpMask bits[4] = {
-        {0x00707070, 9, 5}, // even rows
-        {0x00E0E0E0, 7, 4}, // even rows
-        {0x00070707, 9, 4}, // odd rows
-        {0x000E0E0E, 7, 3}  // odd rows
-    };
-    while(jumpers)
-    {
-        uint32_t jumper = msb(jumpers);
-        int offset = (jumper & 0x00F0F0F0) ? 0 : 2;  // offset for odd rows
-        for (int i = offset; i < 2 + offset; ++i)
-        {
-            bool isJump = bits[i].mask & (empty >> bits[i].empty) & (pieces >> bits[i].enemy) & jumper;
-            if (isJump)
-            {
-                uint32_t jump = jumper | (jumper << bits[i].empty) | (jumper << bits[i].enemy);
-                std::vector<uint32_t> nextJumps;
-                nextJumps.reserve(4);
-                getJumpListUp(jumper << bits[i].empty, pieces, empty ^ (jumper << bits[i].enemy), nextJumps);
-                if (!nextJumps.empty())
-                {
-                    for (const auto& next : nextJumps)
-                    {
-                        jumps.push_back(jump ^ next);
-                    }
-                }
-                else
-                {
-                    jumps.push_back(jump);
-                }
-            }
-        }
-        jumpers ^= jumper;
-    }
+    if (pieces == 0)
+        return 0;
+    uint32_t empty = ~(WhitePieces | BlackPieces);
+    return popcount((empty >> 4) & pieces)
+         + popcount(((empty & 0x70707070) >> 3) & pieces)
+         + popcount(((empty & 0x0E0E0E00) >> 5) & pieces);
 }
 
-void CheckersBitboard::getJumpListTwoSides(uint32_t jumpers, uint32_t pieces, uint32_t empty, std::vector<uint32_t>& jumps) const
+template <typename Output>
+void CheckersBitboard::getJumpListDown(uint32_t jumpers, uint32_t pieces, uint32_t empty, Output& jumps) const
 {
-    static constexpr jumpMask bits[8] = {
-        {0x00707070, 9, 5}, // even up
-        {0x00E0E0E0, 7, 4}, // even up
-        {0x70707000, 7, 3}, // even down
-        {0xE0E0E000, 9, 4}, // even down
-        {0x00070707, 9, 4}, // odd up
-        {0x000E0E0E, 7, 3}, // odd up
-        {0x07070700, 7, 4}, // odd down
-        {0x0E0E0E00, 9, 5}  // odd down
-    };
-    while(jumpers)
-    {
-        uint32_t jumper = msb(jumpers);
-        int offset = (jumper & 0x0F0F0F0F) ? 4 : 0;  // offset for odd rows
-        for (int i = offset; i < 2 + offset; ++i)
-        {
-            // jumps up
-            bool isJump = bits[i].mask & (empty >> bits[i].empty) & (pieces >> bits[i].enemy) & jumper;
-            if (isJump)
-            {
-                uint32_t jump = jumper | (jumper << bits[i].empty) | (jumper << bits[i].enemy);
-                std::vector<uint32_t> nextJumps;
-                nextJumps.reserve(8);
-                getJumpListTwoSides(jumper << bits[i].empty, pieces ^ (jumper << bits[i].enemy), empty ^ jumper, nextJumps);
-                if (!nextJumps.empty())
-                {
-                    for (const auto& next : nextJumps)
-                    {
-                        jumps.push_back(jump ^ next);
-                    }
-                }
-                else
-                {
-                    jumps.push_back(jump);
-                }
-            }
-            // jumps down
-            isJump = bits[i+2].mask & (empty << bits[i+2].empty) & (pieces << bits[i+2].enemy) & jumper;
-            if (isJump)
-            {
-                uint32_t jump = jumper | (jumper >> bits[i+2].empty) | (jumper >> bits[i+2].enemy);
-                std::vector<uint32_t> nextJumps;
-                nextJumps.reserve(8);
-                getJumpListTwoSides(jumper >> bits[i+2].empty, pieces ^ (jumper >> bits[i+2].enemy), empty ^ jumper, nextJumps);
-                if (!nextJumps.empty())
-                {
-                    for (const auto& next : nextJumps)
-                    {
-                        jumps.push_back(jump ^ next);
-                    }
-                }
-                else
-                {
-                    jumps.push_back(jump);
-                }
-            }
-        }
-        jumpers ^= jumper;
-    }
+    walkJumps<DownLeft, DownRight + 1, false>(jumpers, pieces, empty, jumps);
 }
 
+template <typename Output>
+void CheckersBitboard::getJumpListUp(uint32_t jumpers, uint32_t pieces, uint32_t empty, Output& jumps) const
+{
+    walkJumps<UpLeft, UpRight + 1, false>(jumpers, pieces, empty, jumps);
+}
 
-inline uint32_t CheckersBitboard::msb(uint32_t pieces) const
+template <typename Output>
+void CheckersBitboard::getJumpListTwoSides(uint32_t jumpers, uint32_t pieces, uint32_t empty, Output& jumps) const
 {
-    uint64_t n = pieces;
-    n |= n >> 1;
-    n |= n >> 2;
-    n |= n >> 4;
-    n |= n >> 8;
-    n |= n >> 16;
-    n += 1;
-    return n >> 1;
-}
\ No newline at end of file
+    walkJumps<UpLeft, DownRight + 1, true>(jumpers, pieces, empty, jumps);
+}
+
+template uint32_t CheckersBitboard::getMovers<Color::White>() const;
+template uint32_t CheckersBitboard::getMovers<Color::Black>() const;
+template uint32_t CheckersBitboard::getJumpers<Color::White>() const;
+template uint32_t CheckersBitboard::getJumpers<Color::Black>() const;
+template void CheckersBitboard::getMoveList<Color::White>(MoveList&) const;
+template void CheckersBitboard::getMoveList<Color::Black>(MoveList&) const;
+template void CheckersBitboard::getJumpList<Color::White>(uint32_t, MoveList&) const;
+template void CheckersBitboard::getJumpList<Color::Black>(uint32_t, MoveList&) const;
+template int CheckersBitboard::countMoves<Color::White>() const;
+template int CheckersBitboard::countMoves<Color::Black>() const;
+template int CheckersBitboard::countQuietMoves<Color::White>() const;
+template int CheckersBitboard::countQuietMoves<Color::Black>() const;
+template uint32_t CheckersBitboard::getQuietMove<Color::White>(int) const;
+template uint32_t CheckersBitboard::getQuietMove<Color::Black>(int) const;
+template void CheckersBitboard::applyMove<Color::White>(const uint32_t&);
+template void CheckersBitboard::applyMove<Color::Black>(const uint32_t&);
+template void CheckersBitboard::undoMove<Color::White>(const uint32_t&, uint32_t, uint32_t);
+template void CheckersBitboard::undoMove<Color::Black>(const uint32_t&, uint32_t, uint32_t);
@@ -1,16 +1,26 @@
+#pragma once
 #include <cstdint>
 #include <vector>
+#include "bitscan.hpp"
+#include "moveList.hpp"
+#include "squares.hpp"
 
-struct jumpMask
+enum class Color { White, Black };
+
+// compile time properties of side to move
+template <Color color>
+struct ColorTraits
 {
-    uint32_t mask;
-    uint8_t empty;
-    uint8_t enemy;
+    static constexpr Color opponent = color == Color::White ? Color::Black : Color::White;
+    static constexpr bool forwardUp = color == Color::White;  // men move towards higher squares
+    static constexpr uint32_t promotion = color == Color::White ? 0xF0000000 : 0xF;  // last row
 };
 
 class CheckersBitboard
 {
 public:
+    static constexpr const char* name = "compact";
+
     void resetBoard();
     void setWhiteMan(const uint32_t&);
     void setBlackMan(const uint32_t&);
@@ -24,27 +34,73 @@ public:
     uint32_t getBlackMovers() const;
     uint32_t getWhiteJumpers() const;
     uint32_t getBlackJumpers() const;
+    // movers and jumpers of both sides computed in one pass of 64-bit
+    // shifts, white in low and black in high 32 bits
+    uint64_t getBothMovers() const;
+    uint64_t getBothJumpers() const;
 
     std::vector<uint32_t> getWhiteMoveList() const;
     std::vector<uint32_t> getBlackMoveList() const;
 
     std::vector<uint32_t> getWhiteJumpList(uint32_t) const;
     std::vector<uint32_t> getBlackJumpList(uint32_t) const;
+
+    void getWhiteMoveList(MoveList&) const;
+    void getBlackMoveList(MoveList&) const;
+
+    void getWhiteJumpList(uint32_t, MoveList&) const;
+    void getBlackJumpList(uint32_t, MoveList&) const;
+
+    int countWhiteMoves() const;
+    int countBlackMoves() const;
     
     void applyWhiteMove(const uint32_t&);
     void applyBlackMove(const uint32_t&);
 
+    // side specialised core, instantiated for both colors
+    template <Color color>
+    uint32_t getPieces() const { return color == Color::White ? WhitePieces : BlackPieces; }
+    template <Color color>
+    uint32_t getMovers() const;
+    template <Color color>
+    uint32_t getJumpers() const;
+    template <Color color>
+    void getMoveList(MoveList&) const;
+    template <Color color>
+    void getJumpList(uint32_t, MoveList&) const;
+    template <Color color>
+    int countMoves() const;
+    // quiet moves only, valid when side has no captures
+    template <Color color>
+    int countQuietMoves() const;
+    // index-th quiet move built from movers masks, index below countQuietMoves
+    template <Color color>
+    uint32_t getQuietMove(int) const;
+    template <Color color>
+    void applyMove(const uint32_t&);
+    // reverts move given pieces captured by it and kings changed by it
+    template <Color color>
+    void undoMove(const uint32_t&, uint32_t, uint32_t);
+
 private:
+    template <Color color>
+    uint32_t& piecesOf() { return color == Color::White ? WhitePieces : BlackPieces; }
+    template <Color color, typename Output>
+    void getJumps(uint32_t, Output&) const;
     inline uint32_t getMoversDown(const uint32_t&) const;
     inline uint32_t getMoversUp(const uint32_t&) const;
     inline uint32_t getJumpersDown(const uint32_t&, const uint32_t&) const;
     inline uint32_t getJumpersUp(const uint32_t&, const uint32_t&) const;
-    inline void getMoveListDown(uint32_t, std::vector<uint32_t>&) const;
-    inline void getMoveListUp(uint32_t, std::vector<uint32_t>&) const;
-    void getJumpListDown(uint32_t, uint32_t, uint32_t, std::vector<uint32_t>&) const;
-    void getJumpListUp(uint32_t, uint32_t, uint32_t, std::vector<uint32_t>&) const;
-    void getJumpListTwoSides(uint32_t, uint32_t, uint32_t, std::vector<uint32_t>&) const;
-    inline uint32_t msb(uint32_t) const;
+    inline void getMoveListDown(uint32_t, MoveList&) const;
+    inline void getMoveListUp(uint32_t, MoveList&) const;
+    inline int countMovesDown(uint32_t) const;
+    inline int countMovesUp(uint32_t) const;
+    template <typename Output>
+    void getJumpListDown(uint32_t, uint32_t, uint32_t, Output&) const;
+    template <typename Output>
+    void getJumpListUp(uint32_t, uint32_t, uint32_t, Output&) const;
+    template <typename Output>
+    void getJumpListTwoSides(uint32_t, uint32_t, uint32_t, Output&) const;
     uint32_t WhitePieces;
     uint32_t BlackPieces;
     uint32_t Kings;
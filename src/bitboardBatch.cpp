@@ -0,0 +1,123 @@
+#include <cstring>
+#include "bitboardBatch.hpp"
+#include "bitboardBatchKernels.hpp"
+
+namespace
+{
+const batchBackend scalarBackend = {
+    "scalar",
+    batchKernels<scalarOps>::movers,
+    batchKernels<scalarOps>::jumpers,
+    batchKernels<scalarOps>::destinations
+};
+}
+
+#ifdef BATCH_X86
+extern const batchBackend avx2Backend;
+extern const batchBackend avx512Backend;
+#endif
+
+namespace
+{
+const batchBackend* detectBackend()
+{
+#ifdef BATCH_X86
+    if (__builtin_cpu_supports("avx512f"))
+        return &avx512Backend;
+    if (__builtin_cpu_supports("avx2"))
+        return &avx2Backend;
+#endif
+    return &scalarBackend;
+}
+
+const batchBackend* activeBackend = detectBackend();
+}
+
+void BitboardBatch::resize(std::size_t n)
+{
+    WhitePieces.resize(n, 0);
+    BlackPieces.resize(n, 0);
+    Kings.resize(n, 0);
+}
+
+std::size_t BitboardBatch::size() const
+{
+    return WhitePieces.size();
+}
+
+void BitboardBatch::set(std::size_t i, uint32_t white, uint32_t black, uint32_t kings)
+{
+    WhitePieces[i] = white;
+    BlackPieces[i] = black;
+    Kings[i] = kings & (white | black);
+}
+
+uint32_t BitboardBatch::getWhitePieces(std::size_t i) const
+{
+    return WhitePieces[i];
+}
+
+uint32_t BitboardBatch::getBlackPieces(std::size_t i) const
+{
+    return BlackPieces[i];
+}
+
+uint32_t BitboardBatch::getKings(std::size_t i) const
+{
+    return Kings[i];
+}
+
+void BitboardBatch::getMovers(Color color, uint32_t* out) const
+{
+    bool white = color == Color::White;
+    const uint32_t* own = white ? WhitePieces.data() : BlackPieces.data();
+    const uint32_t* enemy = white ? BlackPieces.data() : WhitePieces.data();
+    std::size_t done = activeBackend->movers(own, enemy, Kings.data(), out, size(), white);
+    scalarBackend.movers(own + done, enemy + done, Kings.data() + done, out + done, size() - done, white);
+}
+
+void BitboardBatch::getJumpers(Color color, uint32_t* out) const
+{
+    bool white = color == Color::White;
+    const uint32_t* own = white ? WhitePieces.data() : BlackPieces.data();
+    const uint32_t* enemy = white ? BlackPieces.data() : WhitePieces.data();
+    std::size_t done = activeBackend->jumpers(own, enemy, Kings.data(), out, size(), white);
+    scalarBackend.jumpers(own + done, enemy + done, Kings.data() + done, out + done, size() - done, white);
+}
+
+void BitboardBatch::getDestinations(Color color, uint32_t* const out[4]) const
+{
+    bool white = color == Color::White;
+    const uint32_t* own = white ? WhitePieces.data() : BlackPieces.data();
+    const uint32_t* enemy = white ? BlackPieces.data() : WhitePieces.data();
+    std::size_t done = activeBackend->destinations(own, enemy, Kings.data(), out, size(), white);
+    uint32_t* const rest[4] = { out[0] + done, out[1] + done, out[2] + done, out[3] + done };
+    scalarBackend.destinations(own + done, enemy + done, Kings.data() + done, rest, size() - done, white);
+}
+
+const char* BitboardBatch::getBackend()
+{
+    return activeBackend->name;
+}
+
+bool BitboardBatch::setBackend(const char* name)
+{
+    if (std::strcmp(name, "scalar") == 0)
+    {
+        activeBackend = &scalarBackend;
+        return true;
+    }
+#ifdef BATCH_X86
+    if (std::strcmp(name, "avx2") == 0 && __builtin_cpu_supports("avx2"))
+    {
+        activeBackend = &avx2Backend;
+        return true;
+    }
+    if (std::strcmp(name, "avx512") == 0 && __builtin_cpu_supports("avx512f"))
+    {
+        activeBackend = &avx512Backend;
+        return true;
+    }
+#endif
+    return false;
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "bitboard.hpp"
+
+// kernels of one instruction set, each returns number of boards processed
+// (multiple of its width), remaining boards are finished by scalar kernels
+struct batchBackend
+{
+    const char* name;
+    std::size_t (*movers)(const uint32_t*, const uint32_t*, const uint32_t*, uint32_t*, std::size_t, bool);
+    std::size_t (*jumpers)(const uint32_t*, const uint32_t*, const uint32_t*, uint32_t*, std::size_t, bool);
+    std::size_t (*destinations)(const uint32_t*, const uint32_t*, const uint32_t*, uint32_t* const[4], std::size_t, bool);
+};
+
+// many independent positions stored as structure of arrays, movers, jumpers
+// and single step destinations (indexed by Direction) are computed for 16
+// (AVX-512), 8 (AVX2) or 1 (scalar) boards at a time, chosen at runtime
+class BitboardBatch
+{
+public:
+    void resize(std::size_t);
+    std::size_t size() const;
+    void set(std::size_t, uint32_t, uint32_t, uint32_t);
+
+    uint32_t getWhitePieces(std::size_t) const;
+    uint32_t getBlackPieces(std::size_t) const;
+    uint32_t getKings(std::size_t) const;
+
+    void getMovers(Color, uint32_t*) const;
+    void getJumpers(Color, uint32_t*) const;
+    void getDestinations(Color, uint32_t* const[4]) const;
+
+    static const char* getBackend();
+    // selects backend by name ("scalar", "avx2", "avx512"), false if not supported
+    static bool setBackend(const char*);
+
+private:
+    std::vector<uint32_t> WhitePieces;
+    std::vector<uint32_t> BlackPieces;
+    std::vector<uint32_t> Kings;
+};
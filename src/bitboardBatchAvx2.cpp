@@ -0,0 +1,27 @@
+#include <immintrin.h>
+#include "bitboardBatch.hpp"
+#include "bitboardBatchKernels.hpp"
+
+namespace
+{
+struct avx2Ops
+{
+    using type = __m256i;
+    static constexpr std::size_t width = 8;
+    static type load(const uint32_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    static void store(uint32_t* p, type x) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), x); }
+    static type set(uint32_t x) { return _mm256_set1_epi32(x); }
+    static type bitAnd(type a, type b) { return _mm256_and_si256(a, b); }
+    static type bitOr(type a, type b) { return _mm256_or_si256(a, b); }
+    static type bitNot(type a) { return _mm256_xor_si256(a, _mm256_set1_epi32(-1)); }
+    template <int n> static type shl(type a) { return _mm256_slli_epi32(a, n); }
+    template <int n> static type shr(type a) { return _mm256_srli_epi32(a, n); }
+};
+}
+
+extern const batchBackend avx2Backend = {
+    "avx2",
+    batchKernels<avx2Ops>::movers,
+    batchKernels<avx2Ops>::jumpers,
+    batchKernels<avx2Ops>::destinations
+};
@@ -0,0 +1,27 @@
+#include <immintrin.h>
+#include "bitboardBatch.hpp"
+#include "bitboardBatchKernels.hpp"
+
+namespace
+{
+struct avx512Ops
+{
+    using type = __m512i;
+    static constexpr std::size_t width = 16;
+    static type load(const uint32_t* p) { return _mm512_loadu_si512(reinterpret_cast<const __m512i*>(p)); }
+    static void store(uint32_t* p, type x) { _mm512_storeu_si512(reinterpret_cast<__m512i*>(p), x); }
+    static type set(uint32_t x) { return _mm512_set1_epi32(x); }
+    static type bitAnd(type a, type b) { return _mm512_and_si512(a, b); }
+    static type bitOr(type a, type b) { return _mm512_or_si512(a, b); }
+    static type bitNot(type a) { return _mm512_xor_si512(a, _mm512_set1_epi32(-1)); }
+    template <int n> static type shl(type a) { return _mm512_slli_epi32(a, n); }
+    template <int n> static type shr(type a) { return _mm512_srli_epi32(a, n); }
+};
+}
+
+extern const batchBackend avx512Backend = {
+    "avx512",
+    batchKernels<avx512Ops>::movers,
+    batchKernels<avx512Ops>::jumpers,
+    batchKernels<avx512Ops>::destinations
+};
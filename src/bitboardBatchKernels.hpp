@@ -0,0 +1,138 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// movers, jumpers and destination kernels written once over vector type V
+// each backend translation unit includes this header with its own V and its
+// own compiler flags, so everything stays in anonymous namespace to keep
+// instructions of one backend from leaking into another
+namespace
+{
+struct scalarOps
+{
+    using type = uint32_t;
+    static constexpr std::size_t width = 1;
+    static type load(const uint32_t* p) { return *p; }
+    static void store(uint32_t* p, type x) { *p = x; }
+    static type set(uint32_t x) { return x; }
+    static type bitAnd(type a, type b) { return a & b; }
+    static type bitOr(type a, type b) { return a | b; }
+    static type bitNot(type a) { return ~a; }
+    template <int n> static type shl(type a) { return a << n; }
+    template <int n> static type shr(type a) { return a >> n; }
+};
+
+template <typename V>
+struct batchKernels
+{
+    using T = typename V::type;
+
+    static T moversUp(T pieces, T empty)
+    {
+        T movers = V::bitAnd(V::template shr<4>(empty), pieces);
+        movers = V::bitOr(movers, V::bitAnd(V::template shr<3>(V::bitAnd(empty, V::set(0x70707070))), pieces));
+        movers = V::bitOr(movers, V::bitAnd(V::template shr<5>(V::bitAnd(empty, V::set(0x0E0E0E00))), pieces));
+        return movers;
+    }
+
+    static T moversDown(T pieces, T empty)
+    {
+        T movers = V::bitAnd(V::template shl<4>(empty), pieces);
+        movers = V::bitOr(movers, V::bitAnd(V::template shl<3>(V::bitAnd(empty, V::set(0x0E0E0E0E))), pieces));
+        movers = V::bitOr(movers, V::bitAnd(V::template shl<5>(V::bitAnd(empty, V::set(0x00707070))), pieces));
+        return movers;
+    }
+
+    template <int emptyShift, int enemyShift>
+    static T jumpUp(T jumpers, T enemy, T empty, uint32_t mask)
+    {
+        return V::bitAnd(V::bitAnd(V::bitAnd(jumpers, V::set(mask)), V::template shr<emptyShift>(empty)),
+                         V::template shr<enemyShift>(enemy));
+    }
+
+    template <int emptyShift, int enemyShift>
+    static T jumpDown(T jumpers, T enemy, T empty, uint32_t mask)
+    {
+        return V::bitAnd(V::bitAnd(V::bitAnd(jumpers, V::set(mask)), V::template shl<emptyShift>(empty)),
+                         V::template shl<enemyShift>(enemy));
+    }
+
+    static T jumpersUp(T jumpers, T enemy, T empty)
+    {
+        T jumps = jumpUp<9, 4>(jumpers, enemy, empty, 0x00070707);
+        jumps = V::bitOr(jumps, jumpUp<7, 3>(jumpers, enemy, empty, 0x000E0E0E));
+        jumps = V::bitOr(jumps, jumpUp<9, 5>(jumpers, enemy, empty, 0x00707070));
+        jumps = V::bitOr(jumps, jumpUp<7, 4>(jumpers, enemy, empty, 0x00E0E0E0));
+        return jumps;
+    }
+
+    static T jumpersDown(T jumpers, T enemy, T empty)
+    {
+        T jumps = jumpDown<7, 4>(jumpers, enemy, empty, 0x07070700);
+        jumps = V::bitOr(jumps, jumpDown<9, 5>(jumpers, enemy, empty, 0x0E0E0E00));
+        jumps = V::bitOr(jumps, jumpDown<7, 3>(jumpers, enemy, empty, 0x70707000));
+        jumps = V::bitOr(jumps, jumpDown<9, 4>(jumpers, enemy, empty, 0xE0E0E000));
+        return jumps;
+    }
+
+    // own/enemy are arrays of side to move and its opponent, up - men move up
+    static std::size_t movers(const uint32_t* own, const uint32_t* enemy, const uint32_t* kings,
+                              uint32_t* out, std::size_t n, bool up)
+    {
+        std::size_t i = 0;
+        for (; i + V::width <= n; i += V::width)
+        {
+            T pieces = V::load(own + i);
+            T empty = V::bitNot(V::bitOr(pieces, V::load(enemy + i)));
+            T ownKings = V::bitAnd(pieces, V::load(kings + i));
+            T result = up ? V::bitOr(moversUp(pieces, empty), moversDown(ownKings, empty))
+                          : V::bitOr(moversDown(pieces, empty), moversUp(ownKings, empty));
+            V::store(out + i, result);
+        }
+        return i;
+    }
+
+    static std::size_t jumpers(const uint32_t* own, const uint32_t* enemy, const uint32_t* kings,
+                               uint32_t* out, std::size_t n, bool up)
+    {
+        std::size_t i = 0;
+        for (; i + V::width <= n; i += V::width)
+        {
+            T pieces = V::load(own + i);
+            T opponent = V::load(enemy + i);
+            T empty = V::bitNot(V::bitOr(pieces, opponent));
+            T ownKings = V::bitAnd(pieces, V::load(kings + i));
+            T result = up ? V::bitOr(jumpersUp(pieces, opponent, empty), jumpersDown(ownKings, opponent, empty))
+                          : V::bitOr(jumpersDown(pieces, opponent, empty), jumpersUp(ownKings, opponent, empty));
+            V::store(out + i, result);
+        }
+        return i;
+    }
+
+    // empty squares reachable by single step in each direction (see Direction)
+    static std::size_t destinations(const uint32_t* own, const uint32_t* enemy, const uint32_t* kings,
+                                    uint32_t* const out[4], std::size_t n, bool up)
+    {
+        std::size_t i = 0;
+        for (; i + V::width <= n; i += V::width)
+        {
+            T pieces = V::load(own + i);
+            T empty = V::bitNot(V::bitOr(pieces, V::load(enemy + i)));
+            T ownKings = V::bitAnd(pieces, V::load(kings + i));
+            T upward = up ? pieces : ownKings;
+            T downward = up ? ownKings : pieces;
+            T even = V::set(0x0F0F0F0F), odd = V::set(0xF0F0F0F0);
+            T notFirst = V::set(0x0E0E0E0E), notLast = V::set(0x70707070);
+            T upLeft = V::bitOr(V::template shl<3>(V::bitAnd(upward, notFirst)), V::template shl<4>(V::bitAnd(upward, odd)));
+            T upRight = V::bitOr(V::template shl<4>(V::bitAnd(upward, even)), V::template shl<5>(V::bitAnd(upward, notLast)));
+            T downLeft = V::bitOr(V::template shr<5>(V::bitAnd(downward, notFirst)), V::template shr<4>(V::bitAnd(downward, odd)));
+            T downRight = V::bitOr(V::template shr<4>(V::bitAnd(downward, even)), V::template shr<3>(V::bitAnd(downward, notLast)));
+            V::store(out[0] + i, V::bitAnd(upLeft, empty));
+            V::store(out[1] + i, V::bitAnd(upRight, empty));
+            V::store(out[2] + i, V::bitAnd(downLeft, empty));
+            V::store(out[3] + i, V::bitAnd(downRight, empty));
+        }
+        return i;
+    }
+};
+}
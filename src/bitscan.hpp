@@ -0,0 +1,128 @@
+#pragma once
+#include <cstdint>
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+
+// bit scanning primitives shared by move generation, perft and evaluation
+// compiler builtins map to TZCNT/LZCNT/POPCNT/BLSI/BLSR when target supports them
+
+// isolates lowest set bit (BLSI)
+inline uint32_t lsb(uint32_t pieces)
+{
+    return pieces & (0u - pieces);
+}
+
+// clears lowest set bit (BLSR)
+inline uint32_t clearLsb(uint32_t pieces)
+{
+    return pieces & (pieces - 1);
+}
+
+// index of lowest set bit, pieces must be non-zero
+inline int lsbIndex(uint32_t pieces)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(pieces);
+#else
+    int index = 0;
+    while ((pieces & 1) == 0)
+    {
+        pieces >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+// index of highest set bit, pieces must be non-zero
+inline int msbIndex(uint32_t pieces)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return 31 - __builtin_clz(pieces);
+#else
+    int index = 0;
+    while (pieces >>= 1)
+        index++;
+    return index;
+#endif
+}
+
+// isolates highest set bit, returns 0 for empty set
+inline uint32_t msb(uint32_t pieces)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return pieces ? 1u << msbIndex(pieces) : 0;
+#else
+    uint64_t n = pieces;
+    n |= n >> 1;
+    n |= n >> 2;
+    n |= n >> 4;
+    n |= n >> 8;
+    n |= n >> 16;
+    n += 1;
+    return n >> 1;
+#endif
+}
+
+inline int popcount(uint32_t pieces)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcount(pieces);
+#else
+    pieces = pieces - ((pieces >> 1) & 0x55555555);
+    pieces = (pieces & 0x33333333) + ((pieces >> 2) & 0x33333333);
+    pieces = (pieces + (pieces >> 4)) & 0x0F0F0F0F;
+    return (pieces * 0x01010101) >> 24;
+#endif
+}
+
+inline int popcount64(uint64_t pieces)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(pieces);
+#else
+    return popcount(static_cast<uint32_t>(pieces)) + popcount(static_cast<uint32_t>(pieces >> 32));
+#endif
+}
+
+// isolates n-th lowest set bit (PDEP), returns 0 when pieces has fewer bits
+inline uint32_t nthBit(uint32_t pieces, int n)
+{
+#ifdef __BMI2__
+    return _pdep_u32(1u << n, pieces);
+#else
+    while (n--)
+        pieces = clearLsb(pieces);
+    return lsb(pieces);
+#endif
+}
+
+inline uint64_t nthBit64(uint64_t pieces, int n)
+{
+#ifdef __BMI2__
+    return _pdep_u64(1ull << n, pieces);
+#else
+    while (n--)
+        pieces &= pieces - 1;
+    return pieces & (~pieces + 1);
+#endif
+}
+
+// reverses order of bits, square s goes to 31 - s (board rotated by 180 degrees)
+// clang lowers its builtin to RBIT on ARM, x86 has no bit reverse instruction
+inline uint32_t reverseBits(uint32_t pieces)
+{
+#if defined(__clang__)
+    return __builtin_bitreverse32(pieces);
+#else
+    pieces = ((pieces >> 1) & 0x55555555) | ((pieces & 0x55555555) << 1);
+    pieces = ((pieces >> 2) & 0x33333333) | ((pieces & 0x33333333) << 2);
+    pieces = ((pieces >> 4) & 0x0F0F0F0F) | ((pieces & 0x0F0F0F0F) << 4);
+#if defined(__GNUC__)
+    return __builtin_bswap32(pieces);
+#else
+    return (pieces >> 24) | ((pieces >> 8) & 0xFF00) | ((pieces << 8) & 0xFF0000) | (pieces << 24);
+#endif
+#endif
+}
@@ -0,0 +1,59 @@
+#include <new>
+#include <cstdlib>
+#include "locklessTable.hpp"
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+LocklessTable::LocklessTable(std::size_t megabytes, bool useHugePages)
+{
+    std::size_t buckets = 1;
+    while (buckets * 2 * sizeof(bucket) <= megabytes * 1024 * 1024)
+        buckets *= 2;
+    std::size_t bytes = buckets * sizeof(bucket);
+    void* memory = nullptr;
+#ifdef __linux__
+    // page aligned mmap region can be promoted by kernel to 2 MB pages
+    if (useHugePages)
+    {
+        memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED)
+            memory = nullptr;
+        else
+            hugePages = madvise(memory, bytes, MADV_HUGEPAGE) == 0;
+        if (memory && !hugePages)
+        {
+            munmap(memory, bytes);
+            memory = nullptr;
+        }
+    }
+#endif
+    if (!memory)
+    {
+        memory = std::aligned_alloc(alignof(bucket), bytes);
+        if (!memory)
+            throw std::bad_alloc();
+    }
+    table = static_cast<bucket*>(memory);
+    count = buckets;
+    mask = buckets - 1;
+    clear();
+}
+
+LocklessTable::~LocklessTable()
+{
+#ifdef __linux__
+    if (hugePages)
+    {
+        munmap(table, size());
+        return;
+    }
+#endif
+    std::free(table);
+}
+
+void LocklessTable::clear()
+{
+    for (std::size_t i = 0; i < count; ++i)
+        new (&table[i]) bucket();
+}
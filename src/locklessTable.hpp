@@ -0,0 +1,96 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// hash table of 64-bit (key, data) pairs shared by threads without locks
+// table has power of two number of buckets, each bucket fills one cache line
+// entries are stored as (key ^ data, data) so entry torn by concurrent stores
+// fails verification instead of returning data of other key, data 0 marks
+// empty entry
+class LocklessTable
+{
+public:
+    // hugePages - back table with transparent huge pages when system allows it
+    explicit LocklessTable(std::size_t megabytes, bool hugePages = false);
+    ~LocklessTable();
+    LocklessTable(const LocklessTable&) = delete;
+    LocklessTable& operator=(const LocklessTable&) = delete;
+
+    bool find(uint64_t key, uint64_t& data) const
+    {
+        const bucket& b = table[key & mask];
+        for (const auto& e : b.entries)
+        {
+            uint64_t value = e.data.load(std::memory_order_relaxed);
+            if (value && (e.check.load(std::memory_order_relaxed) ^ value) == key)
+            {
+                data = value;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // replaces entry of the same key, empty entry or the one with lowest
+    // worth(key, data), returns true when entry of other key was evicted
+    template <typename Worth>
+    bool store(uint64_t key, uint64_t data, Worth worth)
+    {
+        bucket& b = table[key & mask];
+        entry* replace = nullptr;
+        int replaceWorth = 0;
+        for (auto& e : b.entries)
+        {
+            uint64_t value = e.data.load(std::memory_order_relaxed);
+            uint64_t stored = e.check.load(std::memory_order_relaxed) ^ value;
+            if (!value || stored == key)
+            {
+                write(e, key, data);
+                return false;
+            }
+            int entryWorth = worth(stored, value);
+            if (!replace || entryWorth < replaceWorth)
+            {
+                replace = &e;
+                replaceWorth = entryWorth;
+            }
+        }
+        write(*replace, key, data);
+        return true;
+    }
+
+    // issue before applyMove with key of position after the move,
+    // so bucket is on its way to cache when child probes it
+    void prefetch(uint64_t key) const
+    {
+        __builtin_prefetch(&table[key & mask]);
+    }
+
+    void clear();
+    std::size_t size() const { return count * sizeof(bucket); }
+    bool usesHugePages() const { return hugePages; }
+
+private:
+    struct entry
+    {
+        std::atomic<uint64_t> check{0};
+        std::atomic<uint64_t> data{0};
+    };
+
+    struct alignas(64) bucket
+    {
+        entry entries[4];
+    };
+
+    static void write(entry& e, uint64_t key, uint64_t data)
+    {
+        e.check.store(key ^ data, std::memory_order_relaxed);
+        e.data.store(data, std::memory_order_relaxed);
+    }
+
+    bucket* table = nullptr;
+    std::size_t count = 0;
+    uint64_t mask = 0;
+    bool hugePages = false;
+};
@@ -0,0 +1,215 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include "mcts.hpp"
+
+NodePool::NodePool(std::size_t capacity) : nodes(new mctsNode[std::max<std::size_t>(capacity, 1)]),
+                                           size(std::max<std::size_t>(capacity, 1))
+{
+    reset();
+}
+
+void NodePool::init(mctsNode& node, uint32_t move)
+{
+    node.move = move;
+    node.firstChild = 0;
+    node.childCount = 0;
+    node.state.store(Leaf, std::memory_order_relaxed);
+    node.visits.store(0, std::memory_order_relaxed);
+    node.reward.store(0, std::memory_order_relaxed);
+}
+
+void NodePool::reset()
+{
+    init(nodes[0], 0);
+    next.store(1, std::memory_order_relaxed);
+}
+
+uint32_t NodePool::allocate(uint32_t n, const MoveList& moves)
+{
+    std::size_t first = next.fetch_add(n, std::memory_order_relaxed);
+    // index past the end stays there, used() is clamped
+    if (first + n > size)
+        return 0;
+    for (uint32_t i = 0; i < n; ++i)
+        init(nodes[first + i], moves[i]);
+    return first;
+}
+
+bool NodePool::exhausted() const
+{
+    return next.load(std::memory_order_relaxed) >= size;
+}
+
+std::size_t NodePool::used() const
+{
+    return std::min(next.load(std::memory_order_relaxed), size);
+}
+
+MctsSearch::MctsSearch(int threads, std::size_t poolNodes) : pool(poolNodes), threads(std::max(1, threads))
+{
+}
+
+void MctsSearch::setExploration(double constant)
+{
+    exploration = constant;
+}
+
+mctsResult MctsSearch::search(const CheckersMoveGenerator& generator, const mctsLimits& searchLimits,
+                              const Xoshiro256& numberGenerator)
+{
+    limits = searchLimits;
+    pool.reset();
+    playouts.store(0, std::memory_order_relaxed);
+    stop.store(false, std::memory_order_relaxed);
+    start = std::chrono::steady_clock::now();
+
+    // each thread gets non-overlapping stream of the same generator
+    Xoshiro256 stream = numberGenerator;
+    std::vector<long long> rounds(threads);
+    std::vector<std::thread> workers;
+    for (int id = 1; id < threads; ++id)
+    {
+        stream.jump();
+        workers.emplace_back(&MctsSearch::worker, this, std::cref(generator), stream, std::ref(rounds[id]));
+    }
+    worker(generator, numberGenerator, rounds[0]);
+    for (auto& thread : workers)
+    {
+        thread.join();
+    }
+
+    mctsResult result;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.playouts = playouts.load(std::memory_order_relaxed);
+    for (auto threadRounds : rounds)
+        result.rounds += threadRounds;
+    result.nodes = pool.used();
+    auto& root = pool[0];
+    if (root.state.load(std::memory_order_acquire) == NodePool::Expanded)
+    {
+        unsigned bestVisits = 0;
+        for (uint32_t i = 0; i < root.childCount; ++i)
+        {
+            auto& child = pool[root.firstChild + i];
+            unsigned visits = child.visits.load(std::memory_order_relaxed);
+            result.rootVisits.emplace_back(child.move, visits);
+            if (visits > bestVisits || result.bestMove == 0)
+            {
+                bestVisits = visits;
+                result.bestMove = child.move;
+                result.winRate = visits ? child.reward.load(std::memory_order_relaxed) / (2.0 * visits) : 0;
+            }
+        }
+    }
+    return result;
+}
+
+void MctsSearch::worker(const CheckersMoveGenerator& root, Xoshiro256 numberGenerator, long long& rounds)
+{
+    std::vector<uint32_t> path;
+    long long threadRounds = 0;
+    for (int iteration = 0; !stop.load(std::memory_order_relaxed); ++iteration)
+    {
+        if (limits.seconds > 0 && (iteration & 63) == 0 &&
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() >= limits.seconds)
+            break;
+        if (playouts.fetch_add(1, std::memory_order_relaxed) >= limits.playouts && limits.playouts > 0)
+        {
+            playouts.fetch_sub(1, std::memory_order_relaxed);
+            break;
+        }
+        CheckersMoveGenerator position = root;
+        iterate(position, numberGenerator, threadRounds, path);
+    }
+    stop.store(true, std::memory_order_relaxed);
+    rounds = threadRounds;
+}
+
+void MctsSearch::iterate(CheckersMoveGenerator& position, Xoshiro256& numberGenerator, long long& rounds,
+                         std::vector<uint32_t>& path)
+{
+    bool rootWhite = position.whiteTurn;
+    path.clear();
+    path.push_back(0);
+    pool[0].visits.fetch_add(1, std::memory_order_relaxed);
+    uint32_t index = 0;
+    while (pool[index].state.load(std::memory_order_acquire) == NodePool::Expanded && pool[index].childCount > 0)
+    {
+        index = selectChild(index);
+        pool[index].visits.fetch_add(1, std::memory_order_relaxed);
+        position.applyMove(pool[index].move);
+        path.push_back(index);
+    }
+    // node being expanded by other thread is simply played out from
+    uint8_t leaf = NodePool::Leaf;
+    if (!pool.exhausted() && pool[index].state.compare_exchange_strong(leaf, NodePool::Expanding, std::memory_order_relaxed))
+    {
+        // playout starts from first new child
+        if (expand(index, position))
+        {
+            index = pool[index].firstChild;
+            pool[index].visits.fetch_add(1, std::memory_order_relaxed);
+            position.applyMove(pool[index].move);
+            path.push_back(index);
+        }
+    }
+
+    GameResult result = playout(position, numberGenerator, rounds);
+    // node at odd depth was reached by move of side to move at root
+    for (std::size_t depth = 0; depth < path.size(); ++depth)
+    {
+        bool whiteMoved = (depth % 2 == 1) == rootWhite;
+        uint32_t reward = result == GameResult::Draw ? 1
+                        : (result == GameResult::WhiteWin) == whiteMoved ? 2 : 0;
+        if (reward)
+            pool[path[depth]].reward.fetch_add(reward, std::memory_order_relaxed);
+    }
+}
+
+// UCT with visits including virtual losses of threads still below child
+uint32_t MctsSearch::selectChild(uint32_t parent)
+{
+    const auto& node = pool[parent];
+    double logVisits = std::log(std::max(1u, node.visits.load(std::memory_order_relaxed)));
+    uint32_t best = node.firstChild;
+    double bestValue = -1;
+    for (uint32_t i = node.firstChild; i < node.firstChild + node.childCount; ++i)
+    {
+        unsigned visits = pool[i].visits.load(std::memory_order_relaxed);
+        if (visits == 0)
+            return i;
+        double value = pool[i].reward.load(std::memory_order_relaxed) / (2.0 * visits)
+                     + exploration * std::sqrt(logVisits / visits);
+        if (value > bestValue)
+        {
+            bestValue = value;
+            best = i;
+        }
+    }
+    return best;
+}
+
+// finished game is expanded to node without children, when pool is full
+// node stays a leaf and is only played out from, returns if children were added
+bool MctsSearch::expand(uint32_t index, CheckersMoveGenerator& position)
+{
+    auto& node = pool[index];
+    MoveList moves;
+    if (!position.isDraw())
+        position.getMovesList(moves);
+    if (!moves.empty())
+    {
+        uint32_t first = pool.allocate(moves.size(), moves);
+        if (first == 0)
+        {
+            node.state.store(NodePool::Leaf, std::memory_order_relaxed);
+            return false;
+        }
+        node.firstChild = first;
+        node.childCount = moves.size();
+    }
+    node.state.store(NodePool::Expanded, std::memory_order_release);
+    return node.childCount > 0;
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "moveGenerator.hpp"
+#include "playout.hpp"
+#include "random.hpp"
+
+struct mctsLimits
+{
+    long long playouts = 100000;  // 0 - no limit
+    double seconds = 0;  // 0 - no limit
+};
+
+struct mctsResult
+{
+    uint32_t bestMove = 0;  // root child with most visits
+    double winRate = 0;  // of best move for side to move, draw counts as half
+    long long playouts = 0;
+    long long rounds = 0;  // random moves played in rollouts
+    std::size_t nodes = 0;  // tree nodes taken from pool
+    double seconds = 0;
+    std::vector<std::pair<uint32_t, unsigned>> rootVisits;
+};
+
+// tree node, children of node are stored one after another in the pool
+// reward is counted in half points for side which made move leading here
+struct mctsNode
+{
+    uint32_t move;
+    uint32_t firstChild;
+    uint16_t childCount;
+    std::atomic<uint8_t> state;  // see NodePool
+    std::atomic<uint32_t> visits;
+    std::atomic<uint32_t> reward;
+};
+
+// preallocated nodes handed out by bumping atomic index, so growing tree
+// never calls malloc, whole pool is released at once by reset
+class NodePool
+{
+public:
+    // node state, only thread which moved node from Leaf to Expanding
+    // fills its children and publishes them by storing Expanded
+    enum : uint8_t { Leaf = 0, Expanding = 1, Expanded = 2 };
+
+    explicit NodePool(std::size_t capacity);
+    // index of first of n consecutive nodes, 0 when pool is exhausted
+    // (node 0 is root and is never handed out again)
+    uint32_t allocate(uint32_t n, const MoveList& moves);
+    void reset();
+    mctsNode& operator[](uint32_t index) { return nodes[index]; }
+    bool exhausted() const;
+    std::size_t used() const;
+    std::size_t capacity() const { return size; }
+
+private:
+    void init(mctsNode&, uint32_t move);
+
+    std::unique_ptr<mctsNode[]> nodes;
+    std::size_t size;
+    std::atomic<std::size_t> next{1};
+};
+
+// UCT tree search with tree parallelism: all threads walk the same tree,
+// visits are counted on the way down (virtual loss) so concurrent threads
+// spread over different branches, rewards are added on the way back
+class MctsSearch
+{
+public:
+    MctsSearch(int threads, std::size_t poolNodes);
+    mctsResult search(const CheckersMoveGenerator&, const mctsLimits&, const Xoshiro256&);
+    void setExploration(double);
+
+private:
+    void worker(const CheckersMoveGenerator&, Xoshiro256, long long& rounds);
+    // one selection, expansion, rollout and backpropagation
+    void iterate(CheckersMoveGenerator&, Xoshiro256&, long long& rounds, std::vector<uint32_t>& path);
+    uint32_t selectChild(uint32_t parent);
+    bool expand(uint32_t index, CheckersMoveGenerator&);
+
+    NodePool pool;
+    int threads;
+    double exploration = 1.41;
+    mctsLimits limits;
+    std::atomic<long long> playouts{0};
+    std::atomic<bool> stop{false};
+    std::chrono::steady_clock::time_point start;
+};
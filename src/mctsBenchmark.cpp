@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <cstdlib>
+#include <unistd.h>
+#include "mcts.hpp"
+#include "search.hpp"
+
+int main(int argc, char *argv[])
+{
+    mctsLimits limits;
+    int threads = 1;
+    std::size_t megabytes = 64;
+    int openingPlies = 0;
+    uint64_t seed = std::random_device()();
+    int opt;
+    while ((opt = getopt(argc, argv, "n:T:t:m:p:s:")) != -1)
+    {
+        if (opt == 'n')
+        {
+            limits.playouts = atoll(optarg);
+        }
+        else if (opt == 'T')
+        {
+            limits.seconds = atoi(optarg) / 1000.0;
+        }
+        else if (opt == 't')
+        {
+            threads = std::max(1, atoi(optarg));
+        }
+        else if (opt == 'm')
+        {
+            megabytes = std::max(1ull, strtoull(optarg, nullptr, 10));
+        }
+        else if (opt == 'p')
+        {
+            openingPlies = std::max(0, atoi(optarg));
+        }
+        else if (opt == 's')
+        {
+            seed = strtoull(optarg, nullptr, 10);
+        }
+    }
+
+    // random opening gives different positions to search from
+    CheckersMoveGenerator generator;
+    Xoshiro256 numberGenerator(seed);
+    MoveList moves;
+    for (int ply = 0; ply < openingPlies; ++ply)
+    {
+        generator.getMovesList(moves);
+        if (moves.empty())
+            break;
+        generator.applyMove(moves[numberGenerator.range(moves.size())]);
+    }
+    std::cout << "seed: " << seed << ", opening plies: " << openingPlies << ", threads: " << threads << std::endl;
+    // board printing leaves stream in hex mode
+    std::cout << generator << std::dec << std::endl;
+
+    MctsSearch search(threads, megabytes * 1024 * 1024 / sizeof(mctsNode));
+    auto result = search.search(generator, limits, numberGenerator);
+    auto state = generator.getState();
+    for (const auto& child : result.rootVisits)
+        std::cout << CheckersSearch::moveToString(state, child.first) << ": " << child.second << std::endl;
+    std::cout << "best move: " << CheckersSearch::moveToString(state, result.bestMove)
+              << " win rate: " << result.winRate << std::endl;
+    std::cout << "playouts: " << result.playouts << std::endl;
+    std::cout << "tree nodes: " << result.nodes << std::endl;
+    std::cout << "time: " << result.seconds << "s" << std::endl;
+    std::cout << "playouts/s: " << result.playouts / result.seconds << std::endl;
+    std::cout << "moves/s: " << result.rounds / result.seconds << std::endl;
+    return 0;
+}
@@ -3,6 +3,7 @@
 CheckersMoveGenerator::CheckersMoveGenerator() : whiteTurn(false)
 {
     board.resetBoard();
+    positionHash = zobristHash(board.getWhitePieces(), board.getBlackPieces(), board.getKings(), whiteTurn);
 }
 
 void CheckersMoveGenerator::resetState()
@@ -10,6 +11,8 @@ void CheckersMoveGenerator::resetState()
     board.resetBoard();
     kingMovesCounter = 0;
     whiteTurn = false;
+    positionHash = zobristHash(board.getWhitePieces(), board.getBlackPieces(), board.getKings(), whiteTurn);
+    resetFlippedHash();
 }
 
 void CheckersMoveGenerator::setState(const gameState& state)
@@ -19,34 +22,134 @@ void CheckersMoveGenerator::setState(const gameState& state)
     board.setKings(state.kings);
     kingMovesCounter = state.counter;
     whiteTurn = state.whiteTurn;
+    if (state.hash)
+        positionHash = state.hash;
+    else
+        positionHash = zobristHash(board.getWhitePieces(), board.getBlackPieces(), board.getKings(), whiteTurn);
+    resetFlippedHash();
 }
 
 gameState CheckersMoveGenerator::getState()
 {
-    return { board.getWhitePieces(), board.getBlackPieces(), board.getKings(), kingMovesCounter, whiteTurn };
+    return { board.getWhitePieces(), board.getBlackPieces(), board.getKings(), kingMovesCounter, whiteTurn, positionHash };
 }
 
 std::vector<uint32_t> CheckersMoveGenerator::getMovesList()
 {
-    std::vector<uint32_t> moves;
+    MoveList moves;
+    getMovesList(moves);
+    return moves.toVector();
+}
+
+void CheckersMoveGenerator::getMovesList(MoveList& moves)
+{
     if (whiteTurn)
+        getMovesList<Color::White>(moves);
+    else
+        getMovesList<Color::Black>(moves);
+}
+
+template <Color color>
+void CheckersMoveGenerator::getMovesList(MoveList& moves)
+{
+    moves.clear();
+    auto jumpers = board.getJumpers<color>();
+    if (jumpers)
     {
-        auto jumpers = board.getWhiteJumpers();
-        if (jumpers)
-            moves =  board.getWhiteJumpList(jumpers);
-        else
-            moves = board.getWhiteMoveList();
-        
+        board.getJumpList<color>(jumpers, moves);
+        // only king sequences can reach the same result by different paths
+        if (uniqueMoves && (jumpers & board.getKings()) && moves.size() > 1)
+            removeDuplicates(moves);
     }
     else
+        board.getMoveList<color>(moves);
+}
+
+int CheckersMoveGenerator::countMoves()
+{
+    return whiteTurn ? countMoves<Color::White>() : countMoves<Color::Black>();
+}
+
+template <Color color>
+int CheckersMoveGenerator::countMoves()
+{
+    if (uniqueMoves && (board.getJumpers<color>() & board.getKings()))
+    {
+        MoveList moves;
+        getMovesList<color>(moves);
+        return moves.size();
+    }
+    return board.countMoves<color>();
+}
+
+uint32_t CheckersMoveGenerator::pickMove(int index)
+{
+    return whiteTurn ? pickMove<Color::White>(index) : pickMove<Color::Black>(index);
+}
+
+template <Color color>
+uint32_t CheckersMoveGenerator::pickMove(int index)
+{
+    if (board.getJumpers<color>())
+    {
+        MoveList moves;
+        getMovesList<color>(moves);
+        return moves[index];
+    }
+    return board.getQuietMove<color>(index);
+}
+
+uint32_t CheckersMoveGenerator::randomMove(Xoshiro256& numberGenerator)
+{
+    return whiteTurn ? randomMove<Color::White>(numberGenerator) : randomMove<Color::Black>(numberGenerator);
+}
+
+template <Color color>
+uint32_t CheckersMoveGenerator::randomMove(Xoshiro256& numberGenerator)
+{
+    // captures are forced and rare, their sequences need the full walk
+    if (board.getJumpers<color>())
     {
-        auto jumpers = board.getBlackJumpers();
-        if (jumpers)
-            moves = board.getBlackJumpList(jumpers);
-        else 
-            moves = board.getBlackMoveList();
+        MoveList moves;
+        getMovesList<color>(moves);
+        return moves[numberGenerator.range(moves.size())];
     }
-    return moves;
+    int count = board.countQuietMoves<color>();
+    if (count == 0)
+        return 0;
+    return board.getQuietMove<color>(numberGenerator.range(count));
+}
+
+void CheckersMoveGenerator::setRemoveDuplicates(bool enabled)
+{
+    uniqueMoves = enabled;
+}
+
+// lists are short, quadratic scan keeping first occurrence is cheapest
+void CheckersMoveGenerator::removeDuplicates(MoveList& moves) const
+{
+    int size = 0;
+    for (int i = 0; i < moves.size(); ++i)
+    {
+        auto mv = moves[i];
+        bool duplicate = false;
+        for (int j = 0; j < size; ++j)
+        {
+            if (moves[j] == mv)
+            {
+                duplicate = true;
+                break;
+            }
+        }
+        if (!duplicate)
+            moves[size++] = mv;
+    }
+    moves.resize(size);
+}
+
+bool CheckersMoveGenerator::hasCaptures()
+{
+    return whiteTurn ? board.getWhiteJumpers() : board.getBlackJumpers();
 }
 
 bool CheckersMoveGenerator::isDraw()
@@ -54,36 +157,138 @@ bool CheckersMoveGenerator::isDraw()
     return kingMovesCounter >= 20;
 }
 
-void CheckersMoveGenerator::applyMove(const uint32_t& mv)
+bool CheckersMoveGenerator::hasAnyMove()
+{
+    if (whiteTurn)
+        return board.getMovers<Color::White>() | board.getJumpers<Color::White>();
+    return board.getMovers<Color::Black>() | board.getJumpers<Color::Black>();
+}
+
+bool CheckersMoveGenerator::isTerminal()
+{
+    return isDraw() || !hasAnyMove();
+}
+
+GameResult CheckersMoveGenerator::outcome()
+{
+    if (isDraw())
+        return GameResult::Draw;
+    if (hasAnyMove())
+        return GameResult::Ongoing;
+    return whiteTurn ? GameResult::BlackWin : GameResult::WhiteWin;
+}
+
+moveUndo CheckersMoveGenerator::applyMove(const uint32_t& mv)
+{
+    if (whiteTurn)
+        return applyMove<Color::White>(mv);
+    return applyMove<Color::Black>(mv);
+}
+
+void CheckersMoveGenerator::undoMove(const uint32_t& mv, const moveUndo& undo)
+{
+    // side which made the move is the one not on turn now
+    if (whiteTurn)
+        undoMove<Color::Black>(mv, undo);
+    else
+        undoMove<Color::White>(mv, undo);
+}
+
+template <Color color>
+moveUndo CheckersMoveGenerator::applyMove(const uint32_t& mv)
 {
     auto white = board.getWhitePieces();
     auto black = board.getBlackPieces();
     auto kings = board.getKings();
-    if (whiteTurn)
+    auto pieces = board.getPieces<color>();
+    auto enemy = board.getPieces<ColorTraits<color>::opponent>();
+    moveUndo undo = { mv & enemy, kings, kingMovesCounter, positionHash, flippedHash };
+    board.applyMove<color>(mv);
+    undo.kings ^= board.getKings();
+    if ((mv & pieces & kings) && ((mv & enemy) == 0))
     {
-        board.applyWhiteMove(mv);
-        if ((mv & white & kings) && ((mv & black) == 0))
-        {
-            kingMovesCounter++;
-        }
-        else
-        {
-            kingMovesCounter = 0;
-        }
+        kingMovesCounter++;
     }
     else
     {
-        board.applyBlackMove(mv);
-        if ((mv & black & kings) && ((mv & white) == 0))
-        {
-            kingMovesCounter++;
-        }
-        else
-        {
-            kingMovesCounter = 0;
-        }
+        kingMovesCounter = 0;
     }
+    positionHash ^= zobristDelta(white, black, kings, board.getWhitePieces(), board.getBlackPieces(), board.getKings());
+    if (canonicalHash)
+        flippedHash ^= zobristDelta(white, black, kings, board.getWhitePieces(), board.getBlackPieces(), board.getKings(),
+                                    zobristKeys.flipped);
+    positionHash ^= zobristKeys.whiteTurn;
     whiteTurn = !whiteTurn;
+    return undo;
+}
+
+template <Color color>
+void CheckersMoveGenerator::undoMove(const uint32_t& mv, const moveUndo& undo)
+{
+    board.undoMove<color>(mv, undo.captured, undo.kings);
+    kingMovesCounter = undo.counter;
+    positionHash = undo.hash;
+    flippedHash = undo.flippedHash;
+    whiteTurn = !whiteTurn;
+}
+
+gameState flipColors(const gameState& state)
+{
+    return { reverseBits(state.black), reverseBits(state.white), reverseBits(state.kings), state.counter, !state.whiteTurn, 0 };
+}
+
+gameState canonicalState(const gameState& state)
+{
+    return state.whiteTurn ? flipColors(state) : state;
+}
+
+void CheckersMoveGenerator::setCanonicalHash(bool enabled)
+{
+    canonicalHash = enabled;
+    resetFlippedHash();
+}
+
+void CheckersMoveGenerator::resetFlippedHash()
+{
+    if (canonicalHash)
+        flippedHash = zobristHash(reverseBits(board.getBlackPieces()), reverseBits(board.getWhitePieces()),
+                                  reverseBits(board.getKings()), false);
+}
+
+// canonical form has black to move, flipped position of white to move
+// is hashed without side to move key as well
+uint64_t CheckersMoveGenerator::hash() const
+{
+    return canonicalHash && whiteTurn ? flippedHash : positionHash;
+}
+
+uint32_t CheckersMoveGenerator::canonicalMove(const uint32_t& mv) const
+{
+    return canonicalHash && whiteTurn ? reverseBits(mv) : mv;
+}
+
+// pieces after move follow from move mask alone (as in applyMove), so only
+// changed squares are hashed and no board copy is made
+uint64_t CheckersMoveGenerator::hashAfter(const uint32_t& mv) const
+{
+    uint32_t white = board.getWhitePieces();
+    uint32_t black = board.getBlackPieces();
+    uint32_t kings = board.getKings();
+    uint32_t own = whiteTurn ? white : black;
+    uint32_t enemy = whiteTurn ? black : white;
+    uint32_t promotion = whiteTurn ? ColorTraits<Color::White>::promotion : ColorTraits<Color::Black>::promotion;
+    uint32_t moved = mv & ~enemy;  // from and to, empty for king capture loop
+    uint32_t newOwn = own ^ moved;
+    uint32_t newKings = kings & ~mv;
+    if ((mv & own & kings) || (moved & newOwn & promotion))
+        newKings |= moved & newOwn;
+    uint32_t newEnemy = enemy & ~mv;
+    uint32_t newWhite = whiteTurn ? newOwn : newEnemy;
+    uint32_t newBlack = whiteTurn ? newEnemy : newOwn;
+    // with canonical hash black to move now means flipped hash after move
+    if (canonicalHash && !whiteTurn)
+        return flippedHash ^ zobristDelta(white, black, kings, newWhite, newBlack, newKings, zobristKeys.flipped);
+    return positionHash ^ zobristKeys.whiteTurn ^ zobristDelta(white, black, kings, newWhite, newBlack, newKings);
 }
 
 std::ostream& operator<< (std::ostream& out, const CheckersMoveGenerator& board)
@@ -115,3 +320,16 @@ std::ostream& operator<< (std::ostream& out, const CheckersMoveGenerator& board)
     out << "white: " << std::hex << white << std::endl << "black: " << black << std::endl;
     return out;
 }
+
+template void CheckersMoveGenerator::getMovesList<Color::White>(MoveList&);
+template void CheckersMoveGenerator::getMovesList<Color::Black>(MoveList&);
+template int CheckersMoveGenerator::countMoves<Color::White>();
+template int CheckersMoveGenerator::countMoves<Color::Black>();
+template uint32_t CheckersMoveGenerator::pickMove<Color::White>(int);
+template uint32_t CheckersMoveGenerator::pickMove<Color::Black>(int);
+template uint32_t CheckersMoveGenerator::randomMove<Color::White>(Xoshiro256&);
+template uint32_t CheckersMoveGenerator::randomMove<Color::Black>(Xoshiro256&);
+template moveUndo CheckersMoveGenerator::applyMove<Color::White>(const uint32_t&);
+template moveUndo CheckersMoveGenerator::applyMove<Color::Black>(const uint32_t&);
+template void CheckersMoveGenerator::undoMove<Color::White>(const uint32_t&, const moveUndo&);
+template void CheckersMoveGenerator::undoMove<Color::Black>(const uint32_t&, const moveUndo&);
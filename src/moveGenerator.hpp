@@ -1,7 +1,20 @@
+#pragma once
 #include <algorithm>
 #include <iostream>
 #include <vector>
 #include "bitboard.hpp"
+#include "paddedBitboard.hpp"
+#include "random.hpp"
+#include "zobrist.hpp"
+
+// board layout used by generator, picked at compile time (PADDED_BOARD option)
+#ifdef PADDED_BOARD
+using GeneratorBoard = PaddedBitboard;
+#else
+using GeneratorBoard = CheckersBitboard;
+#endif
+
+enum class GameResult { WhiteWin, BlackWin, Draw, Ongoing };
 
 struct gameState
 {
@@ -10,6 +23,23 @@ struct gameState
     uint32_t kings;
     uint8_t counter;
     bool whiteTurn;
+    uint64_t hash;  // 0 - recompute on setState
+};
+
+// board rotated by 180 degrees with colours and side to move swapped, has the
+// same moves (bit reversed) and the same result for side to move
+gameState flipColors(const gameState&);
+// one of position and its flip, the one with black to move
+gameState canonicalState(const gameState&);
+
+// minimal information needed to take back a move
+struct moveUndo
+{
+    uint32_t captured;
+    uint32_t kings;  // kings changed by move: moved, promoted or captured
+    uint8_t counter;
+    uint64_t hash;
+    uint64_t flippedHash;
 };
 
 class CheckersMoveGenerator
@@ -20,12 +50,57 @@ public:
     void setState(const gameState&);
     gameState getState();
     std::vector<uint32_t> getMovesList();
+    void getMovesList(MoveList&);
+    int countMoves();
+    bool hasCaptures();
     bool isDraw();
-    void applyMove(const uint32_t&);
+    // answered from movers and jumpers masks, no move list is built
+    bool hasAnyMove();
+    bool isTerminal();
+    // side which can't move loses, Ongoing when game is not over
+    GameResult outcome();
+    // index-th legal move, index below countMoves, quiet moves are built
+    // directly from movers masks and only captures go through move list
+    uint32_t pickMove(int);
+    // uniformly chosen legal move, 0 when side to move has none
+    uint32_t randomMove(Xoshiro256&);
+    // drop king capture sequences with the same result reached by different paths
+    void setRemoveDuplicates(bool);
+    moveUndo applyMove(const uint32_t&);
+    void undoMove(const uint32_t&, const moveUndo&);
+    // hash() of position and its colour flip are the same, tables keyed by it
+    // keep one entry for both
+    void setCanonicalHash(bool);
+    uint64_t hash() const;
+    // move in orientation of canonical position, flipping back is the same call
+    uint32_t canonicalMove(const uint32_t&) const;
+    // hash of position after move, without making it (for prefetching)
+    uint64_t hashAfter(const uint32_t&) const;
+    static const char* boardName() { return GeneratorBoard::name; }
+
+    // side specialised versions, side must match whiteTurn
+    template <Color color>
+    void getMovesList(MoveList&);
+    template <Color color>
+    int countMoves();
+    template <Color color>
+    uint32_t pickMove(int);
+    template <Color color>
+    uint32_t randomMove(Xoshiro256&);
+    template <Color color>
+    moveUndo applyMove(const uint32_t&);
+    template <Color color>
+    void undoMove(const uint32_t&, const moveUndo&);
+
     friend std::ostream& operator<< (std::ostream&, const CheckersMoveGenerator&);
     bool whiteTurn;
 private:
-    std::vector<uint32_t> removeDuplicates(std::vector<uint32_t>&) const;
-    CheckersBitboard board;
+    void removeDuplicates(MoveList&) const;
+    void resetFlippedHash();
+    GeneratorBoard board;
     uint8_t kingMovesCounter = 0;
+    uint64_t positionHash;
+    uint64_t flippedHash = 0;  // hash of flipped position, kept only with canonical hash
+    bool uniqueMoves = true;
+    bool canonicalHash = false;
 };
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+// fixed-capacity, stack-resident list of moves (no heap allocation)
+// quiet move joins piece with empty diagonal neighbour, every square has at
+// most 4 neighbours, so side has at most 4 * min(pieces, empty) <= 64 quiet
+// moves on 32 squares (48 with 12 pieces of real game), capture lists have no
+// such closed bound, the most found is 23 on 20M random boards, so capacity
+// doubles quiet bound and push_back asserts it is not exceeded
+class MoveList
+{
+public:
+    static constexpr int capacity = 128;
+
+    void push_back(const uint32_t& mv)
+    {
+        assert(count < capacity);
+        moves[count++] = mv;
+    }
+    void clear() { count = 0; }
+    void resize(int size)
+    {
+        assert(size <= capacity);
+        count = size;
+    }
+    int size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    uint32_t& operator[](int i) { return moves[i]; }
+    const uint32_t& operator[](int i) const { return moves[i]; }
+
+    uint32_t* begin() { return moves; }
+    uint32_t* end() { return moves + count; }
+    const uint32_t* begin() const { return moves; }
+    const uint32_t* end() const { return moves + count; }
+
+    std::vector<uint32_t> toVector() const { return std::vector<uint32_t>(begin(), end()); }
+
+private:
+    uint32_t moves[capacity];
+    int count = 0;
+};
@@ -0,0 +1,380 @@
+#include <utility>
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+#include "paddedBitboard.hpp"
+
+namespace
+{
+// bits of real squares, 36-bit word with ghosts on bits 4, 13, 22 and 31
+constexpr uint64_t paddedSquares(uint32_t squares)
+{
+    return (squares & 0xF) | static_cast<uint64_t>(squares & 0xFF0) << 1 | static_cast<uint64_t>(squares & 0xFF000) << 2
+         | static_cast<uint64_t>(squares & 0xFF00000) << 3 | static_cast<uint64_t>(squares & 0xF0000000) << 4;
+}
+
+constexpr uint64_t validSquares = paddedSquares(0xFFFFFFFF);
+static_assert(validSquares == 0xF7FBFDFEFULL, "ghost squares before every odd row");
+
+// shift of single diagonal step in direction (see Direction)
+template <int dir>
+inline uint64_t step(uint64_t squares)
+{
+    if constexpr (dir == UpLeft)
+        return squares << 4;
+    else if constexpr (dir == UpRight)
+        return squares << 5;
+    else if constexpr (dir == DownLeft)
+        return squares >> 5;
+    else
+        return squares >> 4;
+}
+
+inline uint64_t stepDir(uint64_t squares, int dir)
+{
+    switch (dir)
+    {
+        case UpLeft: return step<UpLeft>(squares);
+        case UpRight: return step<UpRight>(squares);
+        case DownLeft: return step<DownLeft>(squares);
+        default: return step<DownRight>(squares);
+    }
+}
+
+// squares which have empty square one step in direction up or down
+inline uint64_t moversUp(uint64_t pieces, uint64_t empty)
+{
+    return ((empty >> 4) | (empty >> 5)) & pieces;
+}
+
+inline uint64_t moversDown(uint64_t pieces, uint64_t empty)
+{
+    return ((empty << 4) | (empty << 5)) & pieces;
+}
+
+inline uint64_t jumpersUp(uint64_t pieces, uint64_t enemy, uint64_t empty)
+{
+    return (((empty >> 8) & (enemy >> 4)) | ((empty >> 10) & (enemy >> 5))) & pieces;
+}
+
+inline uint64_t jumpersDown(uint64_t pieces, uint64_t enemy, uint64_t empty)
+{
+    return (((empty << 8) & (enemy << 4)) | ((empty << 10) & (enemy << 5))) & pieces;
+}
+
+struct paddedJumpStep
+{
+    uint64_t square;
+    uint64_t pieces;
+    uint64_t empty;
+    uint64_t path;
+    uint8_t dir;
+    bool last;
+};
+
+constexpr int maxJumpDepth = 16;
+
+struct moveCounter
+{
+    int count = 0;
+    void push_back(const uint32_t&) { count++; }
+};
+
+// same walk as for 32-bit board (men keep captured pieces as enemies, kings
+// remove them and free their start square), neighbours are plain shifts
+template <int firstDir, int lastDir, bool king, typename Output>
+inline void walkJumps(uint64_t jumpers, uint64_t pieces, uint64_t empty, Output& jumps)
+{
+    paddedJumpStep stack[maxJumpDepth];
+    while (jumpers)
+    {
+        int depth = 0;
+        stack[0] = { jumpers & (~jumpers + 1), pieces, empty, 0, firstDir, false };
+        while (depth >= 0)
+        {
+            paddedJumpStep& current = stack[depth];
+            bool found = false;
+            while (current.dir < lastDir)
+            {
+                int dir = current.dir++;
+                uint64_t captured = stepDir(current.square, dir) & current.pieces;
+                uint64_t landing = stepDir(captured, dir) & current.empty;
+                if (landing)
+                {
+                    paddedJumpStep& next = stack[depth + 1];
+                    next.square = landing;
+                    next.pieces = king ? current.pieces ^ captured : current.pieces;
+                    next.empty = king ? current.empty ^ current.square : current.empty ^ captured;
+                    next.path = current.path ^ current.square ^ landing ^ captured;
+                    next.dir = firstDir;
+                    next.last = true;
+                    current.last = false;
+                    found = true;
+                    break;
+                }
+            }
+            if (found)
+            {
+                depth++;
+            }
+            else
+            {
+                if (current.last)
+                    jumps.push_back(PaddedBitboard::toCompact(current.path));
+                depth--;
+            }
+        }
+        jumpers &= jumpers - 1;
+    }
+}
+
+template <int dir>
+inline void pushMoves(uint64_t movers, uint64_t empty, MoveList& moves)
+{
+    uint64_t targets = step<dir>(movers) & empty;
+    while (targets)
+    {
+        uint64_t target = targets & (~targets + 1);
+        constexpr int opposite = 3 - dir;
+        moves.push_back(PaddedBitboard::toCompact(target | step<opposite>(target)));
+        targets ^= target;
+    }
+}
+}
+
+uint64_t PaddedBitboard::toPadded(uint32_t squares)
+{
+#ifdef __BMI2__
+    return _pdep_u64(squares, validSquares);
+#else
+    return paddedSquares(squares);
+#endif
+}
+
+uint32_t PaddedBitboard::toCompact(uint64_t squares)
+{
+#ifdef __BMI2__
+    return _pext_u64(squares, validSquares);
+#else
+    return (squares & 0xF) | ((squares >> 1) & 0xFF0) | ((squares >> 2) & 0xFF000)
+         | ((squares >> 3) & 0xFF00000) | ((squares >> 4) & 0xF0000000);
+#endif
+}
+
+void PaddedBitboard::resetBoard()
+{
+    blackPieces = toPadded(0xFFF00000);
+    whitePieces = toPadded(0xFFF);
+    kings = 0;
+}
+
+void PaddedBitboard::setWhiteMan(const uint32_t& pieces)
+{
+    whitePieces = toPadded(pieces);
+    kings &= blackPieces;
+}
+
+void PaddedBitboard::setBlackMan(const uint32_t& pieces)
+{
+    blackPieces = toPadded(pieces);
+    kings &= whitePieces;
+}
+
+void PaddedBitboard::setKings(const uint32_t& pieces)
+{
+    kings = toPadded(pieces) & (whitePieces | blackPieces);
+}
+
+uint32_t PaddedBitboard::getWhitePieces() const
+{
+    return toCompact(whitePieces);
+}
+
+uint32_t PaddedBitboard::getBlackPieces() const
+{
+    return toCompact(blackPieces);
+}
+
+uint32_t PaddedBitboard::getKings() const
+{
+    return toCompact(kings);
+}
+
+uint32_t PaddedBitboard::getWhiteJumpers() const
+{
+    return getJumpers<Color::White>();
+}
+
+uint32_t PaddedBitboard::getBlackJumpers() const
+{
+    return getJumpers<Color::Black>();
+}
+
+inline uint64_t PaddedBitboard::empty() const
+{
+    return validSquares & ~(whitePieces | blackPieces);
+}
+
+template <Color color>
+uint32_t PaddedBitboard::getPieces() const
+{
+    return toCompact(piecesOf<color>());
+}
+
+template <Color color>
+uint32_t PaddedBitboard::getMovers() const
+{
+    uint64_t pieces = piecesOf<color>();
+    uint64_t free = empty();
+    if constexpr (ColorTraits<color>::forwardUp)
+        return toCompact(moversUp(pieces, free) | moversDown(pieces & kings, free));
+    else
+        return toCompact(moversDown(pieces, free) | moversUp(pieces & kings, free));
+}
+
+template <Color color>
+uint64_t PaddedBitboard::paddedJumpers() const
+{
+    uint64_t pieces = piecesOf<color>();
+    uint64_t enemy = piecesOf<ColorTraits<color>::opponent>();
+    uint64_t free = empty();
+    if constexpr (ColorTraits<color>::forwardUp)
+        return jumpersUp(pieces, enemy, free) | jumpersDown(pieces & kings, enemy, free);
+    else
+        return jumpersDown(pieces, enemy, free) | jumpersUp(pieces & kings, enemy, free);
+}
+
+template <Color color>
+uint32_t PaddedBitboard::getJumpers() const
+{
+    return toCompact(paddedJumpers<color>());
+}
+
+template <Color color>
+void PaddedBitboard::getMoveList(MoveList& moves) const
+{
+    uint64_t pieces = piecesOf<color>();
+    uint64_t free = empty();
+    uint64_t forward = pieces;
+    uint64_t backward = pieces & kings;
+    if constexpr (!ColorTraits<color>::forwardUp)
+        std::swap(forward, backward);
+    pushMoves<UpLeft>(forward, free, moves);
+    pushMoves<UpRight>(forward, free, moves);
+    pushMoves<DownLeft>(backward, free, moves);
+    pushMoves<DownRight>(backward, free, moves);
+}
+
+template <Color color, typename Output>
+void PaddedBitboard::getJumps(uint64_t jumpers, Output& jumps) const
+{
+    uint64_t enemy = piecesOf<ColorTraits<color>::opponent>();
+    uint64_t free = empty();
+    if constexpr (ColorTraits<color>::forwardUp)
+        walkJumps<UpLeft, UpRight + 1, false>(jumpers & ~kings, enemy, free, jumps);
+    else
+        walkJumps<DownLeft, DownRight + 1, false>(jumpers & ~kings, enemy, free, jumps);
+    walkJumps<UpLeft, DownRight + 1, true>(jumpers & kings, enemy, free, jumps);
+}
+
+template <Color color>
+void PaddedBitboard::getJumpList(uint32_t jumpers, MoveList& jumps) const
+{
+    getJumps<color>(toPadded(jumpers), jumps);
+}
+
+template <Color color>
+int PaddedBitboard::countMoves() const
+{
+    uint64_t jumpers = paddedJumpers<color>();
+    if (jumpers)
+    {
+        moveCounter jumps;
+        getJumps<color>(jumpers, jumps);
+        return jumps.count;
+    }
+    return countQuietMoves<color>();
+}
+
+template <Color color>
+int PaddedBitboard::countQuietMoves() const
+{
+    uint64_t pieces = piecesOf<color>();
+    uint64_t free = empty();
+    uint64_t forward = pieces;
+    uint64_t backward = pieces & kings;
+    if constexpr (!ColorTraits<color>::forwardUp)
+        std::swap(forward, backward);
+    return popcount64((forward << 4) & free) + popcount64((forward << 5) & free)
+         + popcount64((backward >> 4) & free) + popcount64((backward >> 5) & free);
+}
+
+template <Color color>
+uint32_t PaddedBitboard::getQuietMove(int index) const
+{
+    uint64_t pieces = piecesOf<color>();
+    uint64_t free = empty();
+    uint64_t forward = pieces;
+    uint64_t backward = pieces & kings;
+    if constexpr (!ColorTraits<color>::forwardUp)
+        std::swap(forward, backward);
+    // empty targets in each direction, piece comes from the opposite one
+    const uint64_t targets[4] = {
+        step<UpLeft>(forward) & free, step<UpRight>(forward) & free,
+        step<DownLeft>(backward) & free, step<DownRight>(backward) & free };
+    for (int dir = 0; dir < 4; ++dir)
+    {
+        int count = popcount64(targets[dir]);
+        if (index < count)
+        {
+            uint64_t target = nthBit64(targets[dir], index);
+            return toCompact(target | stepDir(target, 3 - dir));
+        }
+        index -= count;
+    }
+    return 0;
+}
+
+template <Color color>
+void PaddedBitboard::applyMove(const uint32_t& move)
+{
+    uint64_t mv = toPadded(move);
+    uint64_t& pieces = piecesOf<color>();
+    uint64_t& enemy = piecesOf<ColorTraits<color>::opponent>();
+    bool king = mv & pieces & kings;  // captured kings don't crown capturing man
+    pieces ^= mv & ~enemy;  // move piece
+    enemy &= ~mv;  // remove captured pieces
+    if (king)
+        kings ^= mv & pieces;  // move king if piece=king
+    kings |= mv & pieces & toPadded(ColorTraits<color>::promotion);  // promote
+    kings &= whitePieces | blackPieces;  // remove captured kings
+}
+
+template <Color color>
+void PaddedBitboard::undoMove(const uint32_t& mv, uint32_t captured, uint32_t changedKings)
+{
+    piecesOf<color>() ^= toPadded(mv & ~captured);
+    piecesOf<ColorTraits<color>::opponent>() |= toPadded(captured);
+    kings ^= toPadded(changedKings);
+}
+
+template uint32_t PaddedBitboard::getPieces<Color::White>() const;
+template uint32_t PaddedBitboard::getPieces<Color::Black>() const;
+template uint32_t PaddedBitboard::getMovers<Color::White>() const;
+template uint32_t PaddedBitboard::getMovers<Color::Black>() const;
+template uint32_t PaddedBitboard::getJumpers<Color::White>() const;
+template uint32_t PaddedBitboard::getJumpers<Color::Black>() const;
+template void PaddedBitboard::getMoveList<Color::White>(MoveList&) const;
+template void PaddedBitboard::getMoveList<Color::Black>(MoveList&) const;
+template void PaddedBitboard::getJumpList<Color::White>(uint32_t, MoveList&) const;
+template void PaddedBitboard::getJumpList<Color::Black>(uint32_t, MoveList&) const;
+template int PaddedBitboard::countMoves<Color::White>() const;
+template int PaddedBitboard::countMoves<Color::Black>() const;
+template int PaddedBitboard::countQuietMoves<Color::White>() const;
+template int PaddedBitboard::countQuietMoves<Color::Black>() const;
+template uint32_t PaddedBitboard::getQuietMove<Color::White>(int) const;
+template uint32_t PaddedBitboard::getQuietMove<Color::Black>(int) const;
+template void PaddedBitboard::applyMove<Color::White>(const uint32_t&);
+template void PaddedBitboard::applyMove<Color::Black>(const uint32_t&);
+template void PaddedBitboard::undoMove<Color::White>(const uint32_t&, uint32_t, uint32_t);
+template void PaddedBitboard::undoMove<Color::Black>(const uint32_t&, uint32_t, uint32_t);
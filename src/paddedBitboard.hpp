@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include "bitboard.hpp"
+
+// checkers board in padded layout: ghost square is inserted before every
+// odd row, square s is stored on bit s + (s + 4) / 8 of 36-bit word, so every
+// diagonal step is uniform shift (up left +4, up right +5, down left -5,
+// down right -4) and neighbours outside of board fall on ghost squares
+// pieces and moves are exchanged in 32-bit layout of CheckersBitboard
+class PaddedBitboard
+{
+public:
+    static constexpr const char* name = "padded";
+
+    void resetBoard();
+    void setWhiteMan(const uint32_t&);
+    void setBlackMan(const uint32_t&);
+    void setKings(const uint32_t&);
+
+    uint32_t getWhitePieces() const;
+    uint32_t getBlackPieces() const;
+    uint32_t getKings() const;
+
+    uint32_t getWhiteJumpers() const;
+    uint32_t getBlackJumpers() const;
+
+    template <Color color>
+    uint32_t getPieces() const;
+    template <Color color>
+    uint32_t getMovers() const;
+    template <Color color>
+    uint32_t getJumpers() const;
+    template <Color color>
+    void getMoveList(MoveList&) const;
+    template <Color color>
+    void getJumpList(uint32_t, MoveList&) const;
+    template <Color color>
+    int countMoves() const;
+    template <Color color>
+    int countQuietMoves() const;
+    template <Color color>
+    uint32_t getQuietMove(int) const;
+    template <Color color>
+    void applyMove(const uint32_t&);
+    // reverts move given pieces captured by it and kings changed by it
+    template <Color color>
+    void undoMove(const uint32_t&, uint32_t, uint32_t);
+
+    static uint64_t toPadded(uint32_t);
+    static uint32_t toCompact(uint64_t);
+
+private:
+    template <Color color>
+    uint64_t& piecesOf() { return color == Color::White ? whitePieces : blackPieces; }
+    template <Color color>
+    const uint64_t& piecesOf() const { return color == Color::White ? whitePieces : blackPieces; }
+    template <Color color>
+    uint64_t paddedJumpers() const;
+    template <Color color, typename Output>
+    void getJumps(uint64_t, Output&) const;
+    uint64_t empty() const;
+
+    uint64_t whitePieces;
+    uint64_t blackPieces;
+    uint64_t kings;
+};
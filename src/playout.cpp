@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <utility>
+#include "playout.hpp"
+
+void playoutStats::add(GameResult result)
+{
+    games++;
+    if (result == GameResult::WhiteWin)
+        whiteWins++;
+    else if (result == GameResult::BlackWin)
+        blackWins++;
+    else
+        draws++;
+}
+
+void playoutStats::merge(const playoutStats& other)
+{
+    games += other.games;
+    rounds += other.rounds;
+    whiteWins += other.whiteWins;
+    blackWins += other.blackWins;
+    draws += other.draws;
+}
+
+GameResult playout(CheckersMoveGenerator& generator, Xoshiro256& numberGenerator, long long& rounds)
+{
+    while(1)
+    {
+        if (generator.isDraw())
+            return GameResult::Draw;
+        uint32_t mv = generator.randomMove(numberGenerator);
+        if (mv == 0)
+            return generator.whiteTurn ? GameResult::BlackWin : GameResult::WhiteWin;
+        generator.applyMove(mv);
+        rounds++;
+    }
+}
+
+BatchPlayout::BatchPlayout(std::size_t slots, const Xoshiro256& numberGenerator)
+    : generators(std::max<std::size_t>(slots, 1)), lanes(generators.size()), numberGenerator(numberGenerator)
+{
+    for (auto& side : jumpers)
+        side.resize(generators.size());
+    for (auto& side : destinations)
+        for (auto& dir : side)
+            dir.resize(generators.size());
+}
+
+void BatchPlayout::setRemoveDuplicates(bool enabled)
+{
+    for (auto& generator : generators)
+        generator.setRemoveDuplicates(enabled);
+}
+
+playoutStats BatchPlayout::run(int games)
+{
+    playoutStats stats;
+    std::size_t active = std::min<std::size_t>(generators.size(), std::max(games, 0));
+    int started = active;
+    for (std::size_t slot = 0; slot < active; ++slot)
+        generators[slot].resetState();
+    MoveList moves;
+    while (active > 0)
+    {
+        std::size_t count[2] = {0, 0};
+        for (std::size_t slot = 0; slot < active; ++slot)
+            lanes[slot] = count[generators[slot].whiteTurn ? 0 : 1]++;
+        for (int side = 0; side < 2; ++side)
+            batches[side].resize(count[side]);
+        for (std::size_t slot = 0; slot < active; ++slot)
+        {
+            auto state = generators[slot].getState();
+            batches[state.whiteTurn ? 0 : 1].set(lanes[slot], state.white, state.black, state.kings);
+        }
+        for (auto color : {Color::White, Color::Black})
+        {
+            int side = color == Color::White ? 0 : 1;
+            if (count[side] == 0)
+                continue;
+            auto& batch = batches[side];
+            auto& dirs = destinations[side];
+            uint32_t* const out[4] = { dirs[0].data(), dirs[1].data(), dirs[2].data(), dirs[3].data() };
+            batch.getJumpers(color, jumpers[side].data());
+            batch.getDestinations(color, out);
+        }
+        // backwards, so finished slot can be filled with already advanced last one
+        for (std::size_t slot = active; slot-- > 0;)
+        {
+            if (step(slot, moves, stats.rounds))
+                continue;
+            stats.add(lastResult);
+            if (started < games)
+            {
+                generators[slot].resetState();
+                started++;
+            }
+            else
+            {
+                active--;
+                std::swap(generators[slot], generators[active]);
+            }
+        }
+    }
+    return stats;
+}
+
+// plays one move in slot, returns false and sets lastResult if game is over
+bool BatchPlayout::step(std::size_t slot, MoveList& moves, long long& rounds)
+{
+    auto& generator = generators[slot];
+    if (generator.isDraw())
+    {
+        lastResult = GameResult::Draw;
+        return false;
+    }
+    int side = generator.whiteTurn ? 0 : 1;
+    std::size_t lane = lanes[slot];
+    if (jumpers[side][lane])
+    {
+        generator.getMovesList(moves);
+        generator.applyMove(moves[numberGenerator.range(moves.size())]);
+        rounds++;
+        return true;
+    }
+    int counts[4];
+    int total = 0;
+    for (int dir = 0; dir < 4; ++dir)
+    {
+        counts[dir] = popcount(destinations[side][dir][lane]);
+        total += counts[dir];
+    }
+    if (total == 0)
+    {
+        lastResult = generator.whiteTurn ? GameResult::BlackWin : GameResult::WhiteWin;
+        return false;
+    }
+    int k = numberGenerator.range(total);
+    int dir = 0;
+    while (k >= counts[dir])
+        k -= counts[dir++];
+    uint32_t targets = destinations[side][dir][lane];
+    while (k--)
+        targets = clearLsb(targets);
+    uint32_t target = lsb(targets);
+    // piece came from the opposite diagonal of the target square
+    uint32_t source = squareTable[lsbIndex(target)].step[3 - dir];
+    generator.applyMove(source | target);
+    rounds++;
+    return true;
+}
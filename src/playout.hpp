@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "bitboardBatch.hpp"
+#include "moveGenerator.hpp"
+#include "random.hpp"
+
+// totals of finished random games
+struct playoutStats
+{
+    int games = 0;
+    long long rounds = 0;
+    int whiteWins = 0;
+    int blackWins = 0;
+    int draws = 0;
+
+    void add(GameResult);
+    void merge(const playoutStats&);
+};
+
+// plays random moves from current position until game ends, side which
+// can't move loses, rounds is increased by number of moves played
+GameResult playout(CheckersMoveGenerator&, Xoshiro256&, long long& rounds);
+
+// advances batch of games in lock-step: slots are split by side to move into
+// two BitboardBatch lanes, jumpers and quiet move destinations are computed
+// for each lane only for its side, then one random move is applied in every
+// slot, finished games are replaced with new ones from starting position
+class BatchPlayout
+{
+public:
+    BatchPlayout(std::size_t slots, const Xoshiro256& numberGenerator);
+    void setRemoveDuplicates(bool);
+    playoutStats run(int games);
+
+private:
+    bool step(std::size_t, MoveList&, long long&);
+
+    std::vector<CheckersMoveGenerator> generators;
+    BitboardBatch batches[2];  // white and black to move
+    std::vector<std::size_t> lanes;  // index of slot in batch of its side
+    std::vector<uint32_t> jumpers[2];
+    std::vector<uint32_t> destinations[2][4];
+    Xoshiro256 numberGenerator;
+    GameResult lastResult;
+};
@@ -0,0 +1,89 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+
+// xoshiro256** generator, seeded with splitmix64
+// satisfies UniformRandomBitGenerator so it also works with std distributions
+class Xoshiro256
+{
+public:
+    using result_type = uint64_t;
+
+    explicit Xoshiro256(uint64_t seed = 0)
+    {
+        for (auto& word : state)
+        {
+            seed += 0x9E3779B97F4A7C15ULL;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() { return next(); }
+
+    uint64_t next()
+    {
+        const uint64_t result = rotl(state[1] * 5, 7) * 9;
+        const uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    // uniform number from [0, n) without bias (Lemire's multiply-shift)
+    uint32_t range(uint32_t n)
+    {
+        uint64_t m = (next() >> 32) * n;
+        uint32_t low = static_cast<uint32_t>(m);
+        if (low < n)
+        {
+            uint32_t threshold = (0u - n) % n;
+            while (low < threshold)
+            {
+                m = (next() >> 32) * n;
+                low = static_cast<uint32_t>(m);
+            }
+        }
+        return m >> 32;
+    }
+
+    // advances state by 2^128 steps, used to give each thread its own stream
+    void jump()
+    {
+        static constexpr uint64_t polynomial[] = {
+            0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL
+        };
+        uint64_t s[4] = {0, 0, 0, 0};
+        for (auto word : polynomial)
+        {
+            for (int bit = 0; bit < 64; ++bit)
+            {
+                if (word & (1ULL << bit))
+                {
+                    for (int i = 0; i < 4; ++i)
+                        s[i] ^= state[i];
+                }
+                next();
+            }
+        }
+        for (int i = 0; i < 4; ++i)
+            state[i] = s[i];
+    }
+
+private:
+    static uint64_t rotl(uint64_t x, int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    uint64_t state[4];
+};
@@ -0,0 +1,340 @@
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include "search.hpp"
+
+searchResult CheckersSearch::search(CheckersMoveGenerator& generator, const searchLimits& searchLimits)
+{
+    position = &generator;
+    limits = searchLimits;
+    start = std::chrono::steady_clock::now();
+    nodes = 0;
+    stopped = false;
+    previousPv.clear();
+    tableCounters = tableStats();
+    // parallel search ages table once for all threads
+    if (table && !stopFlag)
+        table->newSearch();
+    auto root = generator.getState();
+    searchResult result;
+    long long previousIterationNodes = 0;
+    int depthStep = helperId % 2 + 1;
+    for (int depth = 1 + helperId % 2; depth <= std::min(limits.depth, maxPly - 1); depth += depthStep)
+    {
+        long long before = nodes;
+        int score = negamax(depth, 0, -winScore - 1, winScore + 1);
+        // keep best move of aborted first iteration, there is nothing better
+        if (stopped && result.depth > 0)
+            break;
+        result.depth = stopped ? 0 : depth;
+        result.score = score;
+        result.pv.assign(pvTable[0], pvTable[0] + pvLength[0]);
+        result.bestMove = result.pv.empty() ? 0 : result.pv[0];
+        if (stopped)
+            break;
+        previousPv = result.pv;
+        long long iterationNodes = nodes - before;
+        if (verbose && helperId == 0)
+        {
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::cout << "depth " << depth << " score " << score << " nodes " << nodes
+                      << " nodes/s " << static_cast<long long>(nodes / std::max(seconds, 1e-9));
+            if (previousIterationNodes > 0)
+                std::cout << " ebf " << static_cast<double>(iterationNodes) / previousIterationNodes;
+            if (table)
+                std::cout << " hits " << 100.0 * tableCounters.hits / std::max(tableCounters.probes, 1ul) << "%";
+            std::cout << " pv";
+            CheckersMoveGenerator line;
+            line.setState(root);
+            for (const auto mv : result.pv)
+            {
+                std::cout << ' ' << moveToString(line.getState(), mv);
+                line.applyMove(mv);
+            }
+            std::cout << std::endl;
+        }
+        previousIterationNodes = iterationNodes;
+        // forced win or loss found, deeper search won't change it
+        if (std::abs(score) >= winScore - maxPly)
+            break;
+    }
+    result.nodes = nodes;
+    result.table = tableCounters;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+void CheckersSearch::setVerbose(bool enabled)
+{
+    verbose = enabled;
+}
+
+void CheckersSearch::setTable(TranspositionTable* transpositionTable)
+{
+    table = transpositionTable;
+}
+
+void CheckersSearch::setStopFlag(const std::atomic<bool>* flag)
+{
+    stopFlag = flag;
+}
+
+void CheckersSearch::setHelper(int id)
+{
+    helperId = id;
+}
+
+namespace
+{
+// win scores are stored as distance from stored position, not from root
+int scoreToTable(int score, int ply)
+{
+    if (score >= winScore - maxPly)
+        return score + ply;
+    if (score <= -winScore + maxPly)
+        return score - ply;
+    return score;
+}
+
+int scoreFromTable(int score, int ply)
+{
+    if (score >= winScore - maxPly)
+        return score - ply;
+    if (score <= -winScore + maxPly)
+        return score + ply;
+    return score;
+}
+}
+
+int CheckersSearch::negamax(int depth, int ply, int alpha, int beta)
+{
+    pvLength[ply] = ply;
+    if (depth <= 0)
+        return quiescence(ply, alpha, beta);
+    nodes++;
+    if ((nodes & 1023) == 0 && outOfBudget())
+        stopped = true;
+    if (stopped)
+        return 0;
+    if (position->isDraw())
+        return 0;
+    if (ply >= maxPly - 1)
+        return evaluate(position->getState());
+
+    // king moves counter is not part of hash, draw distance is ignored by table
+    uint32_t tableMove = 0;
+    tableEntry entry;
+    if (table && table->probe(position->hash(), entry, tableCounters))
+    {
+        tableMove = position->canonicalMove(entry.move);
+        int score = scoreFromTable(entry.score, ply);
+        if (ply > 0 && entry.depth >= depth &&
+            (entry.bound == Bound::Exact ||
+             (entry.bound == Bound::Lower && score >= beta) ||
+             (entry.bound == Bound::Upper && score <= alpha)))
+            return score;
+    }
+
+    MoveList moves;
+    position->getMovesList(moves);
+    if (moves.empty())
+        return -winScore + ply;
+    orderMoves(moves, ply, tableMove);
+    int originalAlpha = alpha;
+    uint32_t bestMove = 0;
+    for (const auto mv : moves)
+    {
+        // child probes table only above quiescence
+        if (table && depth > 1)
+            table->prefetch(position->hashAfter(mv));
+        auto undo = position->applyMove(mv);
+        int score = -negamax(depth - 1, ply + 1, -beta, -alpha);
+        position->undoMove(mv, undo);
+        if (stopped)
+            return 0;
+        if (score > alpha)
+        {
+            alpha = score;
+            bestMove = mv;
+            pvTable[ply][ply] = mv;
+            for (int i = ply + 1; i < pvLength[ply + 1]; ++i)
+                pvTable[ply][i] = pvTable[ply + 1][i];
+            pvLength[ply] = pvLength[ply + 1];
+            if (alpha >= beta)
+                break;
+        }
+    }
+    if (table)
+    {
+        entry.move = position->canonicalMove(bestMove ? bestMove : tableMove);
+        entry.score = scoreToTable(alpha, ply);
+        entry.depth = depth;
+        entry.bound = alpha >= beta ? Bound::Lower : alpha > originalAlpha ? Bound::Exact : Bound::Upper;
+        table->store(position->hash(), entry, tableCounters);
+    }
+    return alpha;
+}
+
+// captures are forced, so position is only evaluated when side to move
+// has no capture, there is no stand pat while captures are pending
+int CheckersSearch::quiescence(int ply, int alpha, int beta)
+{
+    pvLength[ply] = ply;
+    nodes++;
+    if ((nodes & 1023) == 0 && outOfBudget())
+        stopped = true;
+    if (stopped)
+        return 0;
+    if (position->isDraw())
+        return 0;
+    if (!position->hasCaptures() || ply >= maxPly - 1)
+    {
+        if (!position->hasAnyMove())
+            return -winScore + ply;
+        return evaluate(position->getState());
+    }
+
+    MoveList moves;
+    position->getMovesList(moves);
+    for (const auto mv : moves)
+    {
+        auto undo = position->applyMove(mv);
+        int score = -quiescence(ply + 1, -beta, -alpha);
+        position->undoMove(mv, undo);
+        if (stopped)
+            return 0;
+        if (score > alpha)
+        {
+            alpha = score;
+            pvTable[ply][ply] = mv;
+            for (int i = ply + 1; i < pvLength[ply + 1]; ++i)
+                pvTable[ply][i] = pvTable[ply + 1][i];
+            pvLength[ply] = pvLength[ply + 1];
+            if (alpha >= beta)
+                break;
+        }
+    }
+    return alpha;
+}
+
+bool CheckersSearch::outOfBudget()
+{
+    if (stopFlag && stopFlag->load(std::memory_order_relaxed))
+        return true;
+    if (limits.nodes > 0 && nodes >= limits.nodes)
+        return true;
+    if (limits.seconds > 0)
+    {
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return seconds >= limits.seconds;
+    }
+    return false;
+}
+
+// move from table goes first, otherwise move from previous iteration's
+// principal variation
+void CheckersSearch::orderMoves(MoveList& moves, int ply, uint32_t tableMove) const
+{
+    uint32_t first = tableMove;
+    if (!first && ply < static_cast<int>(previousPv.size()))
+        first = previousPv[ply];
+    if (first)
+    {
+        for (int i = 1; i < moves.size(); ++i)
+        {
+            if (moves[i] == first)
+            {
+                std::swap(moves[0], moves[i]);
+                break;
+            }
+        }
+    }
+    if (ply == 0 && helperId > 0 && moves.size() > 2)
+        std::rotate(moves.begin() + 1, moves.begin() + 1 + helperId % (moves.size() - 1), moves.end());
+}
+
+int CheckersSearch::evaluate(const gameState& state)
+{
+    uint32_t whiteMen = state.white & ~state.kings;
+    uint32_t blackMen = state.black & ~state.kings;
+    int score = 100 * (popcount(whiteMen) - popcount(blackMen));
+    score += 300 * (popcount(state.white & state.kings) - popcount(state.black & state.kings));
+    // small bonus for advanced men, rows towards promotion
+    for (int row = 1; row < 7; ++row)
+    {
+        uint32_t rowMask = 0xFu << (row * 4);
+        score += 2 * row * popcount(whiteMen & rowMask);
+        score -= 2 * (7 - row) * popcount(blackMen & rowMask);
+    }
+    return state.whiteTurn ? score : -score;
+}
+
+std::string CheckersSearch::moveToString(const gameState& state, uint32_t mv)
+{
+    uint32_t own = state.whiteTurn ? state.white : state.black;
+    uint32_t enemy = state.whiteTurn ? state.black : state.white;
+    uint32_t from = mv & own;
+    uint32_t to = mv & ~(state.white | state.black);
+    std::ostringstream out;
+    // king capture loop ending on start square has neither from nor to
+    if (from)
+        out << lsbIndex(from) + 1;
+    out << ((mv & enemy) ? 'x' : '-');
+    if (to)
+        out << lsbIndex(to) + 1;
+    else if (from)
+        out << lsbIndex(from) + 1;
+    return out.str();
+}
+
+ParallelSearch::ParallelSearch(int threads)
+{
+    for (int id = 0; id < std::max(1, threads); ++id)
+    {
+        searches.emplace_back(new CheckersSearch());
+        searches.back()->setHelper(id);
+    }
+}
+
+void ParallelSearch::setVerbose(bool enabled)
+{
+    searches[0]->setVerbose(enabled);
+}
+
+searchResult ParallelSearch::search(CheckersMoveGenerator& generator, const searchLimits& limits, TranspositionTable* table)
+{
+    if (table)
+        table->newSearch();
+    std::atomic<bool> stop{false};
+    // every thread works on its own copy of position
+    std::vector<CheckersMoveGenerator> positions(searches.size(), generator);
+    std::vector<searchResult> results(searches.size());
+    searchLimits helperLimits;
+    std::vector<std::thread> helpers;
+    for (std::size_t id = 0; id < searches.size(); ++id)
+    {
+        searches[id]->setTable(table);
+        searches[id]->setStopFlag(&stop);
+        if (id > 0)
+        {
+            helpers.emplace_back([&, id]() {
+                results[id] = searches[id]->search(positions[id], helperLimits);
+            });
+        }
+    }
+    results[0] = searches[0]->search(positions[0], limits);
+    stop.store(true, std::memory_order_relaxed);
+    for (auto& helper : helpers)
+    {
+        helper.join();
+    }
+    searchResult result = results[0];
+    for (std::size_t id = 1; id < results.size(); ++id)
+    {
+        result.nodes += results[id].nodes;
+        result.table.merge(results[id].table);
+    }
+    return result;
+}
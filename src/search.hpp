@@ -0,0 +1,86 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include "moveGenerator.hpp"
+#include "transpositionTable.hpp"
+
+constexpr int maxPly = 128;
+constexpr int winScore = 30000;  // score of won position, minus distance in plies
+
+struct searchLimits
+{
+    int depth = maxPly - 1;
+    long long nodes = 0;  // 0 - no limit
+    double seconds = 0;  // 0 - no limit
+};
+
+// result of last fully searched iteration
+struct searchResult
+{
+    uint32_t bestMove = 0;
+    int score = 0;
+    int depth = 0;
+    long long nodes = 0;  // all iterations including aborted one
+    double seconds = 0;
+    std::vector<uint32_t> pv;
+    tableStats table;
+};
+
+// negamax alpha-beta with iterative deepening, principal variation and
+// quiescence search which follows forced captures
+class CheckersSearch
+{
+public:
+    searchResult search(CheckersMoveGenerator&, const searchLimits&);
+    // called after every finished iteration
+    void setVerbose(bool);
+    // table may be shared with other searches, nullptr - no table
+    void setTable(TranspositionTable*);
+    // search stops when flag is raised, used by parallel search
+    void setStopFlag(const std::atomic<bool>*);
+    // helpers (id > 0) skip depths and rotate root moves to diverge from main
+    void setHelper(int id);
+
+    // material from side to move perspective
+    static int evaluate(const gameState&);
+    // move as "from-to" or "fromxto" for captures, squares numbered 1-32
+    static std::string moveToString(const gameState&, uint32_t);
+
+private:
+    int negamax(int depth, int ply, int alpha, int beta);
+    int quiescence(int ply, int alpha, int beta);
+    bool outOfBudget();
+    void orderMoves(MoveList&, int ply, uint32_t tableMove) const;
+
+    CheckersMoveGenerator* position = nullptr;
+    searchLimits limits;
+    std::chrono::steady_clock::time_point start;
+    long long nodes = 0;
+    bool stopped = false;
+    bool verbose = false;
+    TranspositionTable* table = nullptr;
+    tableStats tableCounters;
+    const std::atomic<bool>* stopFlag = nullptr;
+    int helperId = 0;
+    uint32_t pvTable[maxPly][maxPly];
+    int pvLength[maxPly];
+    std::vector<uint32_t> previousPv;
+};
+
+// lazy SMP: helper threads search the same root with their own generators,
+// sharing only transposition table, result comes from main thread search
+class ParallelSearch
+{
+public:
+    explicit ParallelSearch(int threads);
+    // nodes of result are summed over all threads, node limit applies to main thread
+    searchResult search(CheckersMoveGenerator&, const searchLimits&, TranspositionTable*);
+    void setVerbose(bool);
+    int threads() const { return static_cast<int>(searches.size()); }
+
+private:
+    std::vector<std::unique_ptr<CheckersSearch>> searches;
+};
@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <cstdlib>
+#include <memory>
+#include <unistd.h>
+#include "moveGenerator.hpp"
+#include "random.hpp"
+#include "search.hpp"
+
+// time to depth for 1, 2, 4, ... threads, every run starts with empty table
+void runScaling(CheckersMoveGenerator& generator, const searchLimits& limits, int maxThreads, TranspositionTable& table)
+{
+    double singleThread = 0;
+    for (int threads = 1; ; threads = std::min(threads * 2, maxThreads))
+    {
+        table.clear();
+        ParallelSearch search(threads);
+        auto result = search.search(generator, limits, &table);
+        if (threads == 1)
+            singleThread = result.seconds;
+        std::cout << "threads: " << threads << " depth: " << result.depth << " time: " << result.seconds << "s"
+                  << " speedup: " << singleThread / std::max(result.seconds, 1e-9)
+                  << " nodes/s: " << static_cast<long long>(result.nodes / std::max(result.seconds, 1e-9))
+                  << " best move: " << CheckersSearch::moveToString(generator.getState(), result.bestMove)
+                  << " score: " << result.score << std::endl;
+        if (threads == maxThreads)
+            break;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    searchLimits limits;
+    limits.depth = 12;
+    int openingPlies = 0;
+    uint64_t seed = std::random_device()();
+    std::size_t megabytes = 0;
+    bool hugePages = false;
+    int threads = 1;
+    bool scaling = false;
+    bool canonical = false;
+    int opt;
+    while ((opt = getopt(argc, argv, "d:n:T:p:s:m:lt:xf")) != -1)
+    {
+        if (opt == 'd')
+        {
+            limits.depth = std::max(1, atoi(optarg));
+        }
+        else if (opt == 'n')
+        {
+            limits.nodes = atoll(optarg);
+        }
+        else if (opt == 'T')
+        {
+            limits.seconds = atoi(optarg) / 1000.0;
+        }
+        else if (opt == 'p')
+        {
+            openingPlies = std::max(0, atoi(optarg));
+        }
+        else if (opt == 's')
+        {
+            seed = strtoull(optarg, nullptr, 10);
+        }
+        else if (opt == 'm')
+        {
+            megabytes = strtoull(optarg, nullptr, 10);
+        }
+        else if (opt == 'l')
+        {
+            hugePages = true;
+        }
+        else if (opt == 't')
+        {
+            threads = std::max(1, atoi(optarg));
+        }
+        else if (opt == 'x')
+        {
+            scaling = true;
+        }
+        else if (opt == 'f')
+        {
+            canonical = true;
+        }
+    }
+    // helper threads only help through shared table, default one when not given
+    if ((threads > 1 || scaling) && megabytes == 0)
+        megabytes = 64;
+
+    // random opening gives different positions to search from
+    CheckersMoveGenerator generator;
+    Xoshiro256 numberGenerator(seed);
+    MoveList moves;
+    for (int ply = 0; ply < openingPlies; ++ply)
+    {
+        generator.getMovesList(moves);
+        if (moves.empty())
+            break;
+        generator.applyMove(moves[numberGenerator.range(moves.size())]);
+    }
+    // position and its colour flip share table entries
+    generator.setCanonicalHash(canonical);
+    std::cout << "seed: " << seed << ", opening plies: " << openingPlies << std::endl;
+    // board printing leaves stream in hex mode
+    std::cout << generator << std::dec << std::endl;
+
+    std::unique_ptr<TranspositionTable> table;
+    if (megabytes > 0)
+    {
+        table.reset(new TranspositionTable(megabytes, hugePages));
+        std::cout << "hash table: " << table->size() / (1024 * 1024) << " MB"
+                  << (table->usesHugePages() ? " (huge pages)" : "") << std::endl;
+    }
+    if (scaling)
+    {
+        runScaling(generator, limits, threads, *table);
+        return 0;
+    }
+    ParallelSearch search(threads);
+    search.setVerbose(true);
+    auto result = search.search(generator, limits, table.get());
+    std::cout << "best move: " << CheckersSearch::moveToString(generator.getState(), result.bestMove)
+              << " score: " << result.score << " depth: " << result.depth << std::endl;
+    std::cout << "nodes: " << result.nodes << std::endl;
+    std::cout << "time: " << result.seconds << "s" << std::endl;
+    std::cout << "nodes/s: " << static_cast<long long>(result.nodes / std::max(result.seconds, 1e-9)) << std::endl;
+    if (table)
+    {
+        std::cout << "table probes: " << result.table.probes << " hits: " << result.table.hits
+                  << " stores: " << result.table.stores << " collisions: " << result.table.collisions << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+
+// diagonal directions, up means towards higher square numbers
+enum Direction { UpLeft = 0, UpRight = 1, DownLeft = 2, DownRight = 3 };
+
+// for every square and direction: adjacent square and square two steps away
+// (landing square of a jump), 0 when it falls outside of the board
+struct squareNeighbours
+{
+    uint32_t step[4];
+    uint32_t jump[4];
+};
+
+struct SquareTable
+{
+    squareNeighbours squares[32];
+
+    // square s lies in row s / 4 on file 2 * (s % 4) + row % 2
+    constexpr SquareTable() : squares()
+    {
+        constexpr int rowStep[4] = {1, 1, -1, -1};
+        constexpr int fileStep[4] = {-1, 1, -1, 1};
+        for (int square = 0; square < 32; ++square)
+        {
+            int row = square / 4;
+            int file = 2 * (square % 4) + row % 2;
+            for (int dir = 0; dir < 4; ++dir)
+            {
+                squares[square].step[dir] = bit(row + rowStep[dir], file + fileStep[dir]);
+                squares[square].jump[dir] = bit(row + 2 * rowStep[dir], file + 2 * fileStep[dir]);
+            }
+        }
+    }
+
+    constexpr const squareNeighbours& operator[](int square) const { return squares[square]; }
+
+private:
+    static constexpr uint32_t bit(int row, int file)
+    {
+        if (row < 0 || row > 7 || file < 0 || file > 7)
+            return 0;
+        return 1u << (row * 4 + file / 2);
+    }
+};
+
+static constexpr SquareTable squareTable{};
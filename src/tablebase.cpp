@@ -0,0 +1,483 @@
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <fstream>
+#include <thread>
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+#include "tablebase.hpp"
+
+namespace
+{
+struct BinomialTable
+{
+    uint64_t values[33][13];
+
+    constexpr BinomialTable() : values()
+    {
+        for (int n = 0; n <= 32; ++n)
+        {
+            values[n][0] = 1;
+            for (int k = 1; k <= 12 && k <= n; ++k)
+                values[n][k] = values[n - 1][k - 1] + (k < n ? values[n - 1][k] : 0);
+        }
+    }
+};
+
+constexpr BinomialTable binomial{};
+
+uint64_t choose(int n, int k)
+{
+    return (k < 0 || k > n || k > 12) ? 0 : binomial.values[n][k];
+}
+
+// colex rank of set of positions
+uint64_t rankSet(uint32_t positions)
+{
+    uint64_t rank = 0;
+    for (int i = 1; positions; ++i)
+    {
+        rank += choose(lsbIndex(positions), i);
+        positions = clearLsb(positions);
+    }
+    return rank;
+}
+
+uint32_t unrankSet(uint64_t rank, int k, int n)
+{
+    uint32_t positions = 0;
+    for (int i = k; i > 0; --i)
+    {
+        // largest position p with C(p, i) <= rank
+        int p = i - 1;
+        while (p + 1 < n && choose(p + 1, i) <= rank)
+            ++p;
+        rank -= choose(p, i);
+        positions |= 1u << p;
+        n = p;
+    }
+    return positions;
+}
+
+// numbers of squares counted among free squares only
+uint32_t compress(uint32_t squares, uint32_t free)
+{
+#ifdef __BMI2__
+    return _pext_u32(squares, free);
+#else
+    uint32_t result = 0;
+    for (int i = 0; free; free = clearLsb(free), ++i)
+        if (squares & lsb(free))
+            result |= 1u << i;
+    return result;
+#endif
+}
+
+uint32_t expand(uint32_t positions, uint32_t free)
+{
+#ifdef __BMI2__
+    return _pdep_u32(positions, free);
+#else
+    uint32_t result = 0;
+    for (int i = 0; free; free = clearLsb(free), ++i)
+        if (positions & (1u << i))
+            result |= lsb(free);
+    return result;
+#endif
+}
+
+constexpr uint32_t whiteMenSquares = 0x0FFFFFFF;
+constexpr uint32_t blackMenShift = 4;
+
+int distanceOf(int16_t value)
+{
+    return value > 0 ? value : -value - 1;
+}
+
+// runs work(begin, end) over chunks of [0, size) on threads
+template <typename Work>
+void parallelFor(uint64_t size, int threads, Work work)
+{
+    constexpr uint64_t chunk = 4096;
+    std::atomic<uint64_t> next{0};
+    auto worker = [&]() {
+        uint64_t begin;
+        while ((begin = next.fetch_add(chunk, std::memory_order_relaxed)) < size)
+            work(begin, std::min(begin + chunk, size));
+    };
+    std::vector<std::thread> pool;
+    for (int id = 1; id < threads; ++id)
+        pool.emplace_back(worker);
+    worker();
+    for (auto& thread : pool)
+    {
+        thread.join();
+    }
+}
+
+// calls visit for every position from which quiet move of side which is
+// not to move leads to state: kings step back in any direction, men only
+// backwards
+template <typename Visit>
+void forEachPredecessor(const gameState& state, Visit visit)
+{
+    bool whiteMoved = !state.whiteTurn;
+    uint32_t pieces = whiteMoved ? state.white : state.black;
+    uint32_t empty = ~(state.white | state.black);
+    for (uint32_t rest = pieces; rest; rest = clearLsb(rest))
+    {
+        int square = lsbIndex(rest);
+        uint32_t bit = lsb(rest);
+        bool king = state.kings & bit;
+        // white men move up, so they came from below
+        int firstDir = king || !whiteMoved ? UpLeft : DownLeft;
+        int lastDir = king || whiteMoved ? DownRight : UpRight;
+        for (int dir = firstDir; dir <= lastDir; ++dir)
+        {
+            uint32_t from = squareTable[square].step[dir] & empty;
+            if (!from)
+                continue;
+            gameState previous = state;
+            previous.whiteTurn = whiteMoved;
+            if (whiteMoved)
+                previous.white ^= bit | from;
+            else
+                previous.black ^= bit | from;
+            if (king)
+                previous.kings ^= bit | from;
+            visit(previous);
+        }
+    }
+}
+}
+
+std::string sliceKey::name() const
+{
+    return std::to_string(whiteMen) + std::to_string(whiteKings) + std::to_string(blackMen) + std::to_string(blackKings);
+}
+
+std::vector<sliceKey> Tablebase::slicesUpTo(int maxPieces, bool canonical)
+{
+    std::vector<sliceKey> keys;
+    for (int white = 1; white <= std::min(maxPieces - 1, 12); ++white)
+        for (int black = 1; black <= std::min(maxPieces - white, 12); ++black)
+            for (int whiteMen = 0; whiteMen <= white; ++whiteMen)
+                for (int blackMen = 0; blackMen <= black; ++blackMen)
+                {
+                    sliceKey key{whiteMen, white - whiteMen, blackMen, black - blackMen};
+                    if (!canonical || key.id() <= key.flipped().id())
+                        keys.push_back(key);
+                }
+    // captures lower piece count, promotions lower men count
+    std::stable_sort(keys.begin(), keys.end(), [](const sliceKey& a, const sliceKey& b) {
+        if (a.pieces() != b.pieces())
+            return a.pieces() < b.pieces();
+        return a.whiteMen + a.blackMen < b.whiteMen + b.blackMen;
+    });
+    return keys;
+}
+
+uint64_t Tablebase::sliceSize(const sliceKey& key)
+{
+    int free = 32 - key.whiteMen - key.blackMen;
+    return choose(28, key.whiteMen) * choose(28, key.blackMen) * choose(free, key.whiteKings)
+         * choose(free - key.whiteKings, key.blackKings) * 2;
+}
+
+bool Tablebase::decode(const sliceKey& key, uint64_t index, gameState& state)
+{
+    int free = 32 - key.whiteMen - key.blackMen;
+    bool whiteTurn = (index & 1) == 0;
+    index >>= 1;
+    uint64_t blackKingsCount = choose(free - key.whiteKings, key.blackKings);
+    uint64_t blackKingsRank = index % blackKingsCount;
+    index /= blackKingsCount;
+    uint64_t whiteKingsCount = choose(free, key.whiteKings);
+    uint64_t whiteKingsRank = index % whiteKingsCount;
+    index /= whiteKingsCount;
+    uint64_t blackMenCount = choose(28, key.blackMen);
+    uint32_t blackMen = unrankSet(index % blackMenCount, key.blackMen, 28) << blackMenShift;
+    uint32_t whiteMen = unrankSet(index / blackMenCount, key.whiteMen, 28);
+    if (whiteMen & blackMen)
+        return false;
+    uint32_t empty = ~(whiteMen | blackMen);
+    uint32_t whiteKings = expand(unrankSet(whiteKingsRank, key.whiteKings, free), empty);
+    empty &= ~whiteKings;
+    uint32_t blackKings = expand(unrankSet(blackKingsRank, key.blackKings, free - key.whiteKings), empty);
+    state = {whiteMen | whiteKings, blackMen | blackKings, whiteKings | blackKings, 0, whiteTurn, 0};
+    return true;
+}
+
+uint64_t Tablebase::encode(const sliceKey& key, const gameState& state)
+{
+    int free = 32 - key.whiteMen - key.blackMen;
+    uint32_t whiteMen = state.white & ~state.kings;
+    uint32_t blackMen = state.black & ~state.kings;
+    uint32_t empty = ~(whiteMen | blackMen);
+    uint64_t index = rankSet(whiteMen & whiteMenSquares);
+    index = index * choose(28, key.blackMen) + rankSet(blackMen >> blackMenShift);
+    index = index * choose(free, key.whiteKings) + rankSet(compress(state.white & state.kings, empty));
+    empty &= ~state.white;
+    index = index * choose(free - key.whiteKings, key.blackKings) + rankSet(compress(state.black & state.kings, empty));
+    return index * 2 + (state.whiteTurn ? 0 : 1);
+}
+
+const Tablebase::slice* Tablebase::find(uint32_t white, uint32_t black, uint32_t kings) const
+{
+    sliceKey key{popcount(white & ~kings), popcount(white & kings), popcount(black & ~kings), popcount(black & kings)};
+    if (key.whiteMen > 15 || key.whiteKings > 15 || key.blackMen > 15 || key.blackKings > 15)
+        return nullptr;
+    int index = sliceIndex[key.id()];
+    return index < 0 ? nullptr : slices[index].get();
+}
+
+const Tablebase::slice* Tablebase::locate(gameState& state) const
+{
+    const slice* found = find(state.white, state.black, state.kings);
+    if (!found && canonical)
+    {
+        state = flipColors(state);
+        found = find(state.white, state.black, state.kings);
+    }
+    return found;
+}
+
+bool Tablebase::finalValue(const slice& current, const gameState& state, int16_t& value) const
+{
+    // side without pieces has lost
+    if (!(state.whiteTurn ? state.white : state.black))
+    {
+        value = -1;
+        return true;
+    }
+    // quiet moves keep piece counts, so flipped position is never in current slice
+    gameState position = state;
+    const slice* next = locate(position);
+    if (next == &current)
+        return false;
+    // slices are built in order, missing slice would be a bug in slicesUpTo
+    value = next ? next->values[encode(next->key, position)].load(std::memory_order_relaxed) : 0;
+    return true;
+}
+
+// positions are resolved level by level, level n holds positions won or lost
+// in exactly n plies: win when best losing child is at n - 1, loss when all
+// children are won and the longest at n - 1
+// moves staying in slice are quiet and don't promote, so predecessors of
+// resolved position are found by stepping back single pieces of side which
+// moved, and only they have to be updated, positions never resolved are draws
+void Tablebase::solve(slice& current, int threads, sliceStats& stats)
+{
+    constexpr int16_t none = INT16_MAX;
+    constexpr uint8_t blocked = 0x80;  // child is draw, position can't be lost
+    std::unique_ptr<std::atomic<int16_t>[]> winIn(new std::atomic<int16_t>[current.size]);
+    std::unique_ptr<std::atomic<int16_t>[]> lossIn(new std::atomic<int16_t>[current.size]);
+    // quiet moves inside slice whose result is not known yet
+    std::unique_ptr<std::atomic<uint8_t>[]> pending(new std::atomic<uint8_t>[current.size]);
+    std::atomic<int> lastLevel{0};
+    auto schedule = [&](int level) {
+        int last = lastLevel.load(std::memory_order_relaxed);
+        while (level > last && !lastLevel.compare_exchange_weak(last, level, std::memory_order_relaxed))
+        {
+        }
+    };
+
+    std::atomic<uint64_t> positions{0};
+    parallelFor(current.size, threads, [&](uint64_t begin, uint64_t end) {
+        CheckersMoveGenerator generator;
+        MoveList moves;
+        gameState state;
+        uint64_t localPositions = 0;
+        for (uint64_t index = begin; index < end; ++index)
+        {
+            int win = none, loss = 0;
+            uint8_t unknown = 0;
+            if (decode(current.key, index, state))
+            {
+                localPositions++;
+                generator.setState(state);
+                generator.getMovesList(moves);
+                for (const auto mv : moves)
+                {
+                    auto undo = generator.applyMove(mv);
+                    int16_t value;
+                    if (!finalValue(current, generator.getState(), value))
+                        unknown++;
+                    else if (value == 0)
+                        unknown |= blocked;
+                    else if (value < 0)
+                        win = std::min(win, distanceOf(value) + 1);
+                    else
+                        loss = std::max(loss, distanceOf(value) + 1);
+                    generator.undoMove(mv, undo);
+                }
+                if (win != none)
+                    schedule(win);
+                else if (unknown == 0)
+                    schedule(loss);
+            }
+            else
+                unknown = blocked;
+            winIn[index].store(win, std::memory_order_relaxed);
+            lossIn[index].store(loss, std::memory_order_relaxed);
+            pending[index].store(unknown, std::memory_order_relaxed);
+        }
+        positions += localPositions;
+    });
+    stats.positions = positions;
+
+    for (int level = 0; level <= lastLevel.load(std::memory_order_relaxed); ++level)
+    {
+        std::atomic<uint64_t> wins{0}, losses{0};
+        parallelFor(current.size, threads, [&](uint64_t begin, uint64_t end) {
+            CheckersBitboard board;
+            gameState state;
+            uint64_t localWins = 0, localLosses = 0;
+            for (uint64_t index = begin; index < end; ++index)
+            {
+                if (current.values[index].load(std::memory_order_relaxed) != 0)
+                    continue;
+                // updates made in this level are for level + 1 or later
+                bool won = winIn[index].load(std::memory_order_relaxed) == level;
+                bool lost = !won && pending[index].load(std::memory_order_acquire) == 0 &&
+                            winIn[index].load(std::memory_order_relaxed) == none &&
+                            lossIn[index].load(std::memory_order_relaxed) == level;
+                if (!won && !lost)
+                    continue;
+                current.values[index].store(won ? level : -level - 1, std::memory_order_relaxed);
+                won ? localWins++ : localLosses++;
+
+                decode(current.key, index, state);
+                forEachPredecessor(state, [&](const gameState& predecessor) {
+                    // quiet move is legal only when there is no capture
+                    board.setWhiteMan(predecessor.white);
+                    board.setBlackMan(predecessor.black);
+                    board.setKings(predecessor.kings);
+                    if (predecessor.whiteTurn ? board.getWhiteJumpers() : board.getBlackJumpers())
+                        return;
+                    uint64_t previous = encode(current.key, predecessor);
+                    if (won)
+                    {
+                        int16_t last = lossIn[previous].load(std::memory_order_relaxed);
+                        while (level + 1 > last &&
+                               !lossIn[previous].compare_exchange_weak(last, level + 1, std::memory_order_relaxed))
+                        {
+                        }
+                        if (pending[previous].fetch_sub(1, std::memory_order_acq_rel) == 1 &&
+                            winIn[previous].load(std::memory_order_relaxed) == none)
+                            schedule(lossIn[previous].load(std::memory_order_relaxed));
+                    }
+                    else
+                    {
+                        int16_t best = winIn[previous].load(std::memory_order_relaxed);
+                        while (level + 1 < best &&
+                               !winIn[previous].compare_exchange_weak(best, level + 1, std::memory_order_relaxed))
+                        {
+                        }
+                        schedule(level + 1);
+                    }
+                });
+            }
+            wins += localWins;
+            losses += localLosses;
+        });
+        stats.passes = level + 1;
+        stats.wins += wins;
+        stats.losses += losses;
+        if (wins + losses > 0)
+            stats.maxDistance = level;
+    }
+}
+
+sliceStats Tablebase::build(const sliceKey& key, int threads)
+{
+    auto start = std::chrono::steady_clock::now();
+    slices.emplace_back(new slice{key, sliceSize(key), nullptr});
+    auto& current = *slices.back();
+    current.values.reset(new std::atomic<int16_t>[current.size]());
+    sliceIndex[key.id()] = slices.size() - 1;
+    pieces = std::max(pieces, key.pieces());
+
+    sliceStats stats;
+    solve(current, std::max(1, threads), stats);
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+sliceStats Tablebase::buildAll(int maxPieces, int threads)
+{
+    sliceStats total;
+    for (const auto& key : slicesUpTo(maxPieces, canonical))
+    {
+        if (sliceIndex[key.id()] >= 0)
+            continue;
+        auto stats = build(key, threads);
+        total.positions += stats.positions;
+        total.wins += stats.wins;
+        total.losses += stats.losses;
+        total.passes += stats.passes;
+        total.maxDistance = std::max(total.maxDistance, stats.maxDistance);
+        total.seconds += stats.seconds;
+    }
+    return total;
+}
+
+bool Tablebase::save(const sliceKey& key, const std::string& directory, bool distances) const
+{
+    int index = sliceIndex[key.id()];
+    if (index < 0)
+        return false;
+    const auto& current = *slices[index];
+    std::ofstream out(directory + "/" + key.name() + ".tb", std::ios::binary);
+    if (!out)
+        return false;
+    // header: magic, piece counts, distances flag, number of positions
+    const char header[8] = {'C', 'K', 'T', 'B', static_cast<char>(key.whiteMen), static_cast<char>(key.whiteKings),
+                            static_cast<char>(key.blackMen), static_cast<char>(key.blackKings)};
+    out.write(header, sizeof(header));
+    out.put(distances ? 1 : 0);
+    out.write(reinterpret_cast<const char*>(&current.size), sizeof(current.size));
+    std::vector<char> buffer;
+    if (distances)
+    {
+        buffer.resize(current.size * 2);
+        for (uint64_t i = 0; i < current.size; ++i)
+        {
+            uint16_t value = current.values[i].load(std::memory_order_relaxed);
+            buffer[2 * i] = value & 0xFF;
+            buffer[2 * i + 1] = value >> 8;
+        }
+    }
+    else
+    {
+        // 0 - draw or unused slot, 1 - win, 2 - loss
+        buffer.resize((current.size + 3) / 4);
+        for (uint64_t i = 0; i < current.size; ++i)
+        {
+            int16_t value = current.values[i].load(std::memory_order_relaxed);
+            int code = value > 0 ? 1 : value < 0 ? 2 : 0;
+            buffer[i / 4] |= code << (2 * (i % 4));
+        }
+    }
+    out.write(buffer.data(), buffer.size());
+    return static_cast<bool>(out);
+}
+
+tablebaseValue Tablebase::probe(const gameState& state) const
+{
+    tablebaseValue result;
+    if (!(state.whiteTurn ? state.white : state.black))
+    {
+        result.result = TablebaseResult::Loss;
+        return result;
+    }
+    gameState position = state;
+    const slice* current = locate(position);
+    if (!current)
+        return result;
+    int16_t value = current->values[encode(current->key, position)].load(std::memory_order_relaxed);
+    result.result = value > 0 ? TablebaseResult::Win : value < 0 ? TablebaseResult::Loss : TablebaseResult::Draw;
+    result.distance = value ? distanceOf(value) : 0;
+    return result;
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "moveGenerator.hpp"
+
+// piece counts of one tablebase slice
+struct sliceKey
+{
+    int whiteMen;
+    int whiteKings;
+    int blackMen;
+    int blackKings;
+
+    int pieces() const { return whiteMen + whiteKings + blackMen + blackKings; }
+    int id() const { return whiteMen | whiteKings << 4 | blackMen << 8 | blackKings << 12; }
+    // slice of colour flipped positions
+    sliceKey flipped() const { return {blackMen, blackKings, whiteMen, whiteKings}; }
+    // "WmWkBmBk", e.g. 2011 for two white men against black man and king
+    std::string name() const;
+};
+
+enum class TablebaseResult { Unknown, Win, Loss, Draw };
+
+// result for side to move and distance to end of game in plies
+struct tablebaseValue
+{
+    TablebaseResult result = TablebaseResult::Unknown;
+    int distance = 0;
+};
+
+struct sliceStats
+{
+    uint64_t positions = 0;  // valid positions, index space has a few unused slots
+    uint64_t wins = 0;
+    uint64_t losses = 0;
+    int passes = 0;  // distance levels scanned
+    int maxDistance = 0;
+    double seconds = 0;
+};
+
+// endgame tablebase solved by retrograde analysis
+// positions of a slice are indexed by colex ranks of white men (28 squares
+// below white promotion row), black men (28 squares above black promotion
+// row), white kings and black kings (squares left free by earlier pieces)
+// and side to move, only index slots with white and black man on the same
+// square are unused
+// king moves counter is ignored, so values are exact without 20 moves draw rule
+class Tablebase
+{
+public:
+    // slices with both sides on board and at most maxPieces pieces, ordered
+    // so that every slice comes after all slices its moves lead to, with
+    // canonical only one slice of every pair of colour flipped slices
+    static std::vector<sliceKey> slicesUpTo(int maxPieces, bool canonical = false);
+    static uint64_t sliceSize(const sliceKey&);
+
+    // slices which moves of this slice lead to must be built before
+    sliceStats build(const sliceKey&, int threads);
+    sliceStats buildAll(int maxPieces, int threads);
+    // writes <directory>/<slice name>.tb, 2 bits per position win/loss/draw
+    // or with distances 16 bits per position: 0 draw, n > 0 win in n plies,
+    // n < 0 loss in -n - 1 plies
+    bool save(const sliceKey&, const std::string& directory, bool distances) const;
+
+    tablebaseValue probe(const gameState&) const;
+    int maxPieces() const { return pieces; }
+    // positions of slices not built are looked up in colour flipped slice,
+    // buildAll then builds canonical slices only
+    void setCanonical(bool enabled) { canonical = enabled; }
+
+private:
+    struct slice
+    {
+        sliceKey key;
+        uint64_t size;
+        std::unique_ptr<std::atomic<int16_t>[]> values;
+    };
+
+    static bool decode(const sliceKey&, uint64_t index, gameState&);
+    static uint64_t encode(const sliceKey&, const gameState&);
+    const slice* find(uint32_t white, uint32_t black, uint32_t kings) const;
+    // slice holding position, state is flipped when it's found in flipped slice
+    const slice* locate(gameState&) const;
+    // value of position from already built slice, false for position of slice being solved
+    bool finalValue(const slice& current, const gameState&, int16_t& value) const;
+    void solve(slice&, int threads, sliceStats&);
+
+    std::vector<std::unique_ptr<slice>> slices;
+    std::vector<int> sliceIndex = std::vector<int>(1 << 16, -1);
+    int pieces = 0;
+    bool canonical = false;
+};
@@ -0,0 +1,64 @@
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <cstdlib>
+#include <unistd.h>
+#include "tablebase.hpp"
+
+int main(int argc, char *argv[])
+{
+    int maxPieces = 4;
+    int threads = std::max(1u, std::thread::hardware_concurrency());
+    std::string directory;
+    bool distances = false;
+    bool canonical = false;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:t:o:df")) != -1)
+    {
+        if (opt == 'n')
+        {
+            maxPieces = std::max(2, atoi(optarg));
+        }
+        else if (opt == 't')
+        {
+            threads = std::max(1, atoi(optarg));
+        }
+        else if (opt == 'o')
+        {
+            directory = optarg;
+        }
+        else if (opt == 'd')
+        {
+            distances = true;
+        }
+        else if (opt == 'f')
+        {
+            canonical = true;
+        }
+    }
+    std::cout << "building tablebase up to " << maxPieces << " pieces on " << threads << " threads"
+              << (canonical ? ", colour flipped slices skipped" : "") << std::endl;
+    Tablebase tablebase;
+    tablebase.setCanonical(canonical);
+    sliceStats total;
+    for (const auto& key : Tablebase::slicesUpTo(maxPieces, canonical))
+    {
+        auto stats = tablebase.build(key, threads);
+        std::cout << "slice " << key.name() << ": positions: " << stats.positions << " wins: " << stats.wins
+                  << " losses: " << stats.losses << " draws: " << stats.positions - stats.wins - stats.losses
+                  << " longest: " << stats.maxDistance << " passes: " << stats.passes
+                  << " time: " << stats.seconds << "s" << std::endl;
+        if (!directory.empty() && !tablebase.save(key, directory, distances))
+        {
+            std::cerr << "can't write slice " << key.name() << " to " << directory << std::endl;
+            return 1;
+        }
+        total.positions += stats.positions;
+        total.seconds += stats.seconds;
+    }
+    std::cout << "positions: " << total.positions << std::endl;
+    std::cout << "time: " << total.seconds << "s" << std::endl;
+    std::cout << "positions/s: " << total.positions / total.seconds << std::endl;
+    return 0;
+}
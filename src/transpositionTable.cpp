@@ -0,0 +1,59 @@
+#include "transpositionTable.hpp"
+
+TranspositionTable::TranspositionTable(std::size_t megabytes, bool hugePages)
+    : table(megabytes, hugePages)
+{
+}
+
+void TranspositionTable::clear()
+{
+    table.clear();
+    age.store(0, std::memory_order_relaxed);
+}
+
+void TranspositionTable::newSearch()
+{
+    age.store((age.load(std::memory_order_relaxed) + 1) & 0x3F, std::memory_order_relaxed);
+}
+
+uint64_t TranspositionTable::pack(const tableEntry& value, uint8_t age)
+{
+    return static_cast<uint64_t>(value.move)
+         | static_cast<uint64_t>(static_cast<uint16_t>(value.score)) << 32
+         | static_cast<uint64_t>(value.depth & 0xFF) << 48
+         | static_cast<uint64_t>(value.bound) << 56
+         | static_cast<uint64_t>(age) << 58;
+}
+
+tableEntry TranspositionTable::unpack(uint64_t data)
+{
+    tableEntry value;
+    value.move = static_cast<uint32_t>(data);
+    value.score = static_cast<int16_t>(data >> 32);
+    value.depth = depthOf(data);
+    value.bound = static_cast<Bound>((data >> 56) & 0x3);
+    return value;
+}
+
+bool TranspositionTable::probe(uint64_t hash, tableEntry& result, tableStats& stats) const
+{
+    stats.probes++;
+    uint64_t data;
+    if (!table.find(hash, data))
+        return false;
+    stats.hits++;
+    result = unpack(data);
+    return true;
+}
+
+void TranspositionTable::store(uint64_t hash, const tableEntry& value, tableStats& stats)
+{
+    stats.stores++;
+    uint8_t currentAge = age.load(std::memory_order_relaxed);
+    // every search of age distance costs entry 8 plies of depth
+    auto worth = [currentAge](uint64_t, uint64_t data) {
+        return depthOf(data) - 8 * ((currentAge - ageOf(data)) & 0x3F);
+    };
+    if (table.store(hash, pack(value, currentAge), worth))
+        stats.collisions++;
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "locklessTable.hpp"
+
+enum class Bound : uint8_t { None = 0, Upper = 1, Lower = 2, Exact = 3 };
+
+struct tableEntry
+{
+    uint32_t move = 0;
+    int score = 0;
+    int depth = 0;
+    Bound bound = Bound::None;
+};
+
+// counters kept by every thread on its own and merged for reporting
+struct tableStats
+{
+    unsigned long probes = 0;
+    unsigned long hits = 0;
+    unsigned long stores = 0;
+    unsigned long collisions = 0;  // stores evicting entry of another position
+
+    void merge(const tableStats& other)
+    {
+        probes += other.probes;
+        hits += other.hits;
+        stores += other.stores;
+        collisions += other.collisions;
+    }
+};
+
+// transposition table shared by search threads without locks, entries of
+// LocklessTable keyed by position hash
+class TranspositionTable
+{
+public:
+    // hugePages - back table with transparent huge pages when system allows it
+    explicit TranspositionTable(std::size_t megabytes, bool hugePages = false);
+
+    bool probe(uint64_t hash, tableEntry& result, tableStats& stats) const;
+    // replaces the same position, empty entry or the shallowest, oldest one
+    void store(uint64_t hash, const tableEntry& value, tableStats& stats);
+    // starts new search, entries of older searches are replaced first
+    void newSearch();
+    void clear();
+
+    // issue before applyMove with hash of position after the move,
+    // so bucket is on its way to cache when child probes it
+    void prefetch(uint64_t hash) const { table.prefetch(hash); }
+
+    std::size_t size() const { return table.size(); }
+    bool usesHugePages() const { return table.usesHugePages(); }
+
+private:
+    // data: move (32 bits), score (16), depth (8), bound (2), age (6)
+    static uint64_t pack(const tableEntry& value, uint8_t age);
+    static tableEntry unpack(uint64_t data);
+    static uint8_t ageOf(uint64_t data) { return data >> 58; }
+    static int depthOf(uint64_t data) { return (data >> 48) & 0xFF; }
+
+    LocklessTable table;
+    std::atomic<uint8_t> age{0};
+};
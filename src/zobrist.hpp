@@ -0,0 +1,83 @@
+#pragma once
+#include <cstdint>
+#include "bitscan.hpp"
+
+// zobrist keys generated at compile time with splitmix64
+// index: 0 - white man, 1 - black man, 2 - white king, 3 - black king
+// flipped keys hash position as if colours were flipped (key of piece with
+// swapped colour on square 31 - s), so both hashes share one delta walk
+struct ZobristKeys
+{
+    uint64_t pieces[4][32];
+    uint64_t flipped[4][32];
+    uint64_t whiteTurn;
+
+    constexpr ZobristKeys() : pieces(), flipped(), whiteTurn(0)
+    {
+        uint64_t state = 0x2545F4914F6CDD1DULL;
+        for (int kind = 0; kind < 4; ++kind)
+            for (int square = 0; square < 32; ++square)
+                pieces[kind][square] = next(state);
+        whiteTurn = next(state);
+        for (int kind = 0; kind < 4; ++kind)
+            for (int square = 0; square < 32; ++square)
+                flipped[kind][square] = pieces[kind ^ 1][31 - square];
+    }
+
+private:
+    static constexpr uint64_t next(uint64_t& state)
+    {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+};
+
+static constexpr ZobristKeys zobristKeys{};
+
+// hash of pieces standing on squares from mask
+inline uint64_t zobristSquares(uint32_t white, uint32_t black, uint32_t kings, uint32_t mask)
+{
+    uint64_t hash = 0;
+    mask &= white | black;
+    while (mask)
+    {
+        int square = lsbIndex(mask);
+        uint32_t bit = lsb(mask);
+        int kind = ((black & bit) ? 1 : 0) + ((kings & bit) ? 2 : 0);
+        hash ^= zobristKeys.pieces[kind][square];
+        mask ^= bit;
+    }
+    return hash;
+}
+
+// hash difference between two positions, only changed pieces are visited
+inline uint64_t zobristDelta(uint32_t white, uint32_t black, uint32_t kings,
+                             uint32_t newWhite, uint32_t newBlack, uint32_t newKings,
+                             const uint64_t (&keys)[4][32] = zobristKeys.pieces)
+{
+    const uint32_t changed[4] = {
+        (white & ~kings) ^ (newWhite & ~newKings),
+        (black & ~kings) ^ (newBlack & ~newKings),
+        (white & kings) ^ (newWhite & newKings),
+        (black & kings) ^ (newBlack & newKings)
+    };
+    uint64_t hash = 0;
+    for (int kind = 0; kind < 4; ++kind)
+    {
+        uint32_t mask = changed[kind];
+        while (mask)
+        {
+            hash ^= keys[kind][lsbIndex(mask)];
+            mask = clearLsb(mask);
+        }
+    }
+    return hash;
+}
+
+inline uint64_t zobristHash(uint32_t white, uint32_t black, uint32_t kings, bool whiteTurn)
+{
+    uint64_t hash = zobristSquares(white, black, kings, 0xFFFFFFFF);
+    return whiteTurn ? hash ^ zobristKeys.whiteTurn : hash;
+}
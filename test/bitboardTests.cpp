@@ -1,8 +1,17 @@
 #define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_NO_POSIX_SIGNALS
 #include <algorithm>
 #include <vector>
 #include <catch.hpp>
 #include <bitboard.hpp>
+#include <bitboardBatch.hpp>
+#include <paddedBitboard.hpp>
+#include <moveGenerator.hpp>
+#include <playout.hpp>
+#include <random.hpp>
+#include <mcts.hpp>
+#include <search.hpp>
+#include <tablebase.hpp>
 
 using namespace Catch::Matchers;
 
@@ -16,6 +25,17 @@ uint32_t generateBitboard(const std::vector<int>& pieces)
     return board;
 }
 
+// quiet moves of board built one by one from index, sorted
+template <Color color, typename Board>
+std::vector<uint32_t> quietMovesByIndex(const Board& board)
+{
+    std::vector<uint32_t> moves;
+    for (int i = 0; i < board.template countQuietMoves<color>(); ++i)
+        moves.push_back(board.template getQuietMove<color>(i));
+    std::sort(moves.begin(), moves.end());
+    return moves;
+}
+
 TEST_CASE("Checkers bitboard should", "")
 {
     CheckersBitboard bitboard;
@@ -444,5 +464,742 @@ TEST_CASE("Checkers bitboard should", "")
         REQUIRE(bitboard.getWhitePieces() == generateBitboard({6}));
         REQUIRE(bitboard.getKings() == bitboard.getWhitePieces());
     }
+
+    SECTION("remove black king from the board when white man jumps and keep man")
+    {
+        bitboard.setBlackMan(generateBitboard({4}));
+        bitboard.setWhiteMan(generateBitboard({0}));
+        bitboard.setKings(generateBitboard({4}));
+        uint32_t move = generateBitboard({0,4,9});
+        bitboard.applyWhiteMove(move);
+        REQUIRE(bitboard.getBlackPieces() == 0);
+        REQUIRE(bitboard.getWhitePieces() == generateBitboard({9}));
+        REQUIRE(bitboard.getKings() == 0);
+    }
+
+    SECTION("fill caller-owned move list with the same moves as vector api")
+    {
+        bitboard.resetBoard();
+        MoveList moves;
+        bitboard.getWhiteMoveList(moves);
+        REQUIRE_THAT(moves.toVector(), Equals(bitboard.getWhiteMoveList()));
+
+        bitboard.setBlackMan(generateBitboard({9,10,17,18,25,26}));
+        bitboard.setWhiteMan(generateBitboard({5}));
+        bitboard.setKings(generateBitboard({5}));
+        auto jumpers = bitboard.getWhiteJumpers();
+        moves.clear();
+        bitboard.getWhiteJumpList(jumpers, moves);
+        REQUIRE_FALSE(moves.empty());
+        REQUIRE_THAT(moves.toVector(), Equals(bitboard.getWhiteJumpList(jumpers)));
+    }
+
+    SECTION("count moves without generating them")
+    {
+        bitboard.resetBoard();
+        REQUIRE(bitboard.countWhiteMoves() == 7);
+        REQUIRE(bitboard.countBlackMoves() == 7);
+
+        bitboard.setBlackMan(generateBitboard({9,10,17,18,25,26}));
+        bitboard.setWhiteMan(generateBitboard({5,14}));
+        bitboard.setKings(generateBitboard({5}));
+        REQUIRE(bitboard.countWhiteMoves() == (int)bitboard.getWhiteJumpList(bitboard.getWhiteJumpers()).size());
+        REQUIRE(bitboard.countBlackMoves() == (int)bitboard.getBlackJumpList(bitboard.getBlackJumpers()).size());
+    }
+}
+
+TEST_CASE("Bit scan should", "")
+{
+    SECTION("isolate and clear lowest and highest set bits")
+    {
+        uint32_t pieces = generateBitboard({3,17,31});
+        REQUIRE(lsb(pieces) == generateBitboard({3}));
+        REQUIRE(clearLsb(pieces) == generateBitboard({17,31}));
+        REQUIRE(msb(pieces) == generateBitboard({31}));
+        REQUIRE(msb(0) == 0);
+        REQUIRE(lsbIndex(pieces) == 3);
+        REQUIRE(msbIndex(pieces) == 31);
+        REQUIRE(popcount(pieces) == 3);
+        REQUIRE(popcount(0xFFFFFFFF) == 32);
+    }
+}
+
+TEST_CASE("Square table should", "")
+{
+    SECTION("give adjacent and landing squares on board edges and in the middle")
+    {
+        REQUIRE(squareTable[0].step[UpLeft] == 0);
+        REQUIRE(squareTable[0].step[UpRight] == generateBitboard({4}));
+        REQUIRE(squareTable[0].jump[UpRight] == generateBitboard({9}));
+        REQUIRE(squareTable[0].step[DownRight] == 0);
+        REQUIRE(squareTable[13].step[UpLeft] == generateBitboard({17}));
+        REQUIRE(squareTable[13].step[UpRight] == generateBitboard({18}));
+        REQUIRE(squareTable[13].step[DownLeft] == generateBitboard({9}));
+        REQUIRE(squareTable[13].step[DownRight] == generateBitboard({10}));
+        REQUIRE(squareTable[13].jump[UpLeft] == generateBitboard({20}));
+        REQUIRE(squareTable[13].jump[DownRight] == generateBitboard({6}));
+        REQUIRE(squareTable[31].jump[UpLeft] == 0);
+    }
+}
+
+TEST_CASE("Packed movers and jumpers should", "")
+{
+    SECTION("match separate results of both sides")
+    {
+        Xoshiro256 numberGenerator(22);
+        CheckersBitboard bitboard;
+        for (int i = 0; i < 20000; ++i)
+        {
+            // sparse and dense boards
+            uint32_t occupied = i % 2 ? numberGenerator() : numberGenerator() & numberGenerator();
+            uint32_t white = occupied & numberGenerator();
+            bitboard.setWhiteMan(white);
+            bitboard.setBlackMan(occupied & ~white);
+            bitboard.setKings(numberGenerator() & numberGenerator());
+            uint64_t movers = bitboard.getBothMovers();
+            uint64_t jumpers = bitboard.getBothJumpers();
+            REQUIRE(static_cast<uint32_t>(movers) == bitboard.getWhiteMovers());
+            REQUIRE(static_cast<uint32_t>(movers >> 32) == bitboard.getBlackMovers());
+            REQUIRE(static_cast<uint32_t>(jumpers) == bitboard.getWhiteJumpers());
+            REQUIRE(static_cast<uint32_t>(jumpers >> 32) == bitboard.getBlackJumpers());
+        }
+    }
+}
+
+TEST_CASE("Padded bitboard should", "")
+{
+    SECTION("convert squares to padded layout and back")
+    {
+        REQUIRE(PaddedBitboard::toPadded(0x1) == 0x1);
+        REQUIRE(PaddedBitboard::toPadded(0x10) == 0x20);
+        REQUIRE(PaddedBitboard::toPadded(0x80000000) == 0x800000000ULL);
+        REQUIRE(PaddedBitboard::toCompact(PaddedBitboard::toPadded(0x12345678)) == 0x12345678);
+    }
+    SECTION("generate the same moves as 32-bit board")
+    {
+        Xoshiro256 numberGenerator(21);
+        CheckersBitboard compact;
+        PaddedBitboard padded;
+        for (int i = 0; i < 5000; ++i)
+        {
+            uint32_t occupied = numberGenerator() & numberGenerator();
+            uint32_t white = occupied & numberGenerator();
+            uint32_t kings = numberGenerator() & numberGenerator();
+            compact.setWhiteMan(white);
+            compact.setBlackMan(occupied & ~white);
+            compact.setKings(kings);
+            padded.setWhiteMan(white);
+            padded.setBlackMan(occupied & ~white);
+            padded.setKings(kings);
+            REQUIRE(padded.getKings() == compact.getKings());
+            REQUIRE(padded.getMovers<Color::White>() == compact.getMovers<Color::White>());
+            REQUIRE(padded.getMovers<Color::Black>() == compact.getMovers<Color::Black>());
+            REQUIRE(padded.getWhiteJumpers() == compact.getWhiteJumpers());
+            REQUIRE(padded.getBlackJumpers() == compact.getBlackJumpers());
+            REQUIRE(padded.countMoves<Color::White>() == compact.countMoves<Color::White>());
+            REQUIRE(padded.countMoves<Color::Black>() == compact.countMoves<Color::Black>());
+            MoveList expected, actual;
+            auto jumpers = compact.getWhiteJumpers();
+            if (jumpers)
+            {
+                compact.getJumpList<Color::White>(jumpers, expected);
+                padded.getJumpList<Color::White>(jumpers, actual);
+            }
+            else
+            {
+                compact.getMoveList<Color::White>(expected);
+                padded.getMoveList<Color::White>(actual);
+            }
+            auto expectedMoves = expected.toVector(), actualMoves = actual.toVector();
+            std::sort(expectedMoves.begin(), expectedMoves.end());
+            std::sort(actualMoves.begin(), actualMoves.end());
+            REQUIRE(actualMoves == expectedMoves);
+            for (const auto mv : actualMoves)
+            {
+                auto before = padded;
+                padded.applyMove<Color::White>(mv);
+                compact.applyMove<Color::White>(mv);
+                REQUIRE(padded.getWhitePieces() == compact.getWhitePieces());
+                REQUIRE(padded.getBlackPieces() == compact.getBlackPieces());
+                REQUIRE(padded.getKings() == compact.getKings());
+                compact.setWhiteMan(white);
+                compact.setBlackMan(occupied & ~white);
+                compact.setKings(kings);
+                padded = before;
+            }
+        }
+    }
+
+    SECTION("build every quiet move from its index")
+    {
+        Xoshiro256 numberGenerator(22);
+        CheckersBitboard compact;
+        PaddedBitboard padded;
+        for (int i = 0; i < 2000; ++i)
+        {
+            uint32_t occupied = numberGenerator() & numberGenerator();
+            uint32_t white = occupied & numberGenerator();
+            uint32_t kings = numberGenerator() & numberGenerator();
+            compact.setWhiteMan(white);
+            compact.setBlackMan(occupied & ~white);
+            compact.setKings(kings);
+            padded.setWhiteMan(white);
+            padded.setBlackMan(occupied & ~white);
+            padded.setKings(kings);
+            MoveList whiteList, blackList;
+            compact.getMoveList<Color::White>(whiteList);
+            compact.getMoveList<Color::Black>(blackList);
+            auto whiteMoves = whiteList.toVector(), blackMoves = blackList.toVector();
+            std::sort(whiteMoves.begin(), whiteMoves.end());
+            std::sort(blackMoves.begin(), blackMoves.end());
+            REQUIRE(quietMovesByIndex<Color::White>(compact) == whiteMoves);
+            REQUIRE(quietMovesByIndex<Color::Black>(compact) == blackMoves);
+            REQUIRE(quietMovesByIndex<Color::White>(padded) == whiteMoves);
+            REQUIRE(quietMovesByIndex<Color::Black>(padded) == blackMoves);
+        }
+    }
+
+    SECTION("keep man that captures king for both colours")
+    {
+        PaddedBitboard padded;
+        padded.setWhiteMan(generateBitboard({0}));
+        padded.setBlackMan(generateBitboard({4}));
+        padded.setKings(generateBitboard({4}));
+        padded.applyMove<Color::White>(generateBitboard({0,4,9}));
+        REQUIRE(padded.getWhitePieces() == generateBitboard({9}));
+        REQUIRE(padded.getBlackPieces() == 0);
+        REQUIRE(padded.getKings() == 0);
+        padded.setWhiteMan(generateBitboard({27}));
+        padded.setBlackMan(generateBitboard({31}));
+        padded.setKings(generateBitboard({27}));
+        padded.applyMove<Color::Black>(generateBitboard({31,27,22}));
+        REQUIRE(padded.getBlackPieces() == generateBitboard({22}));
+        REQUIRE(padded.getWhitePieces() == 0);
+        REQUIRE(padded.getKings() == 0);
+    }
+}
+
+TEST_CASE("Bitboard batch should", "")
+{
+    // odd size so vector backends leave a scalar tail
+    const std::size_t boards = 101;
+    BitboardBatch batch;
+    batch.resize(boards);
+    std::vector<CheckersBitboard> bitboards(boards);
+    Xoshiro256 numberGenerator(7);
+    for (std::size_t i = 0; i < boards; ++i)
+    {
+        uint32_t occupied = numberGenerator() & numberGenerator();
+        uint32_t white = occupied & numberGenerator();
+        uint32_t kings = numberGenerator() & numberGenerator();
+        batch.set(i, white, occupied & ~white, kings);
+        bitboards[i].setWhiteMan(white);
+        bitboards[i].setBlackMan(occupied & ~white);
+        bitboards[i].setKings(kings);
+    }
+
+    for (const char* backend : {"scalar", "avx2", "avx512"})
+    {
+        if (!BitboardBatch::setBackend(backend))
+            continue;
+        SECTION(std::string("compute movers, jumpers and destinations like single bitboard with ") + backend)
+        {
+            std::vector<uint32_t> movers(boards), jumpers(boards), destinations[4];
+            for (auto& d : destinations)
+                d.resize(boards);
+            uint32_t* const out[4] = { destinations[0].data(), destinations[1].data(), destinations[2].data(), destinations[3].data() };
+            for (auto color : {Color::White, Color::Black})
+            {
+                batch.getMovers(color, movers.data());
+                batch.getJumpers(color, jumpers.data());
+                batch.getDestinations(color, out);
+                for (std::size_t i = 0; i < boards; ++i)
+                {
+                    bool white = color == Color::White;
+                    REQUIRE(movers[i] == (white ? bitboards[i].getWhiteMovers() : bitboards[i].getBlackMovers()));
+                    REQUIRE(jumpers[i] == (white ? bitboards[i].getWhiteJumpers() : bitboards[i].getBlackJumpers()));
+                    MoveList moves;
+                    if (white)
+                        bitboards[i].getWhiteMoveList(moves);
+                    else
+                        bitboards[i].getBlackMoveList(moves);
+                    int count = 0;
+                    for (int dir = 0; dir < 4; ++dir)
+                        count += popcount(destinations[dir][i]);
+                    REQUIRE(count == moves.size());
+                }
+            }
+        }
+    }
+    BitboardBatch::setBackend("scalar");
+}
+
+TEST_CASE("Move generator should", "")
+{
+    CheckersMoveGenerator generator;
+
+    SECTION("update position hash incrementally")
+    {
+        REQUIRE(generator.hash() == zobristHash(0xFFF, 0xFFF00000, 0, false));
+        for (int i = 0; i < 200; ++i)
+        {
+            auto moves = generator.getMovesList();
+            if (moves.empty())
+                break;
+            for (const auto mv : moves)
+            {
+                auto expected = generator.hashAfter(mv);
+                auto undo = generator.applyMove(mv);
+                REQUIRE(generator.hash() == expected);
+                generator.undoMove(mv, undo);
+            }
+            generator.applyMove(moves[(i * 7) % moves.size()]);
+            auto state = generator.getState();
+            REQUIRE(generator.hash() == zobristHash(state.white, state.black, state.kings, state.whiteTurn));
+        }
+    }
+
+    SECTION("hash man capturing king the same as after move")
+    {
+        generator.setState({ generateBitboard({0}), generateBitboard({4, 31}), generateBitboard({4}), 0, true, 0 });
+        uint32_t mv = generateBitboard({0,4,9});
+        REQUIRE(generator.getMovesList() == std::vector<uint32_t>{ mv });
+        auto expected = generator.hashAfter(mv);
+        generator.applyMove(mv);
+        REQUIRE(generator.getState().kings == 0);
+        REQUIRE(generator.hash() == expected);
+    }
+
+    SECTION("undo moves back to the same state")
+    {
+        for (int i = 0; i < 200; ++i)
+        {
+            auto moves = generator.getMovesList();
+            if (moves.empty())
+                break;
+            for (const auto mv : moves)
+            {
+                auto before = generator.getState();
+                auto undo = generator.applyMove(mv);
+                generator.undoMove(mv, undo);
+                auto after = generator.getState();
+                REQUIRE(after.white == before.white);
+                REQUIRE(after.black == before.black);
+                REQUIRE(after.kings == before.kings);
+                REQUIRE(after.counter == before.counter);
+                REQUIRE(after.whiteTurn == before.whiteTurn);
+                REQUIRE(after.hash == before.hash);
+            }
+            generator.applyMove(moves[(i * 5) % moves.size()]);
+        }
+    }
+
+    SECTION("report king capture loop reached by both directions once")
+    {
+        generator.setState({generateBitboard({13}), generateBitboard({17,18,25,26}), generateBitboard({13}), 0, true, 0});
+        REQUIRE_THAT(generator.getMovesList(), Equals(std::vector<uint32_t>{generateBitboard({17,18,25,26})}));
+        REQUIRE(generator.countMoves() == 1);
+
+        generator.setRemoveDuplicates(false);
+        REQUIRE(generator.getMovesList().size() == 2);
+        REQUIRE(generator.countMoves() == 2);
+    }
+
+    SECTION("detect end of game without building move list")
+    {
+        for (int i = 0; i < 300; ++i)
+        {
+            auto moves = generator.getMovesList();
+            REQUIRE(generator.hasAnyMove() == !moves.empty());
+            REQUIRE(generator.isTerminal() == (generator.isDraw() || moves.empty()));
+            if (generator.isTerminal())
+                break;
+            REQUIRE(generator.outcome() == GameResult::Ongoing);
+            generator.applyMove(moves[(i * 7) % moves.size()]);
+        }
+
+        // black man on the last row can't move any further
+        generator.setState({generateBitboard({9}), generateBitboard({0}), 0, 0, false, 0});
+        REQUIRE(!generator.hasAnyMove());
+        REQUIRE(generator.outcome() == GameResult::WhiteWin);
+
+        generator.setState({0, generateBitboard({20}), 0, 0, true, 0});
+        REQUIRE(generator.outcome() == GameResult::BlackWin);
+
+        generator.setState({generateBitboard({9}), generateBitboard({20}), generateBitboard({9, 20}), 20, true, 0});
+        REQUIRE(generator.hasAnyMove());
+        REQUIRE(generator.outcome() == GameResult::Draw);
+    }
+
+    SECTION("pick every legal move by index")
+    {
+        Xoshiro256 numberGenerator(23);
+        for (int i = 0; i < 300; ++i)
+        {
+            auto moves = generator.getMovesList();
+            if (moves.empty() || generator.isDraw())
+                break;
+            std::vector<uint32_t> picked;
+            for (int index = 0; index < generator.countMoves(); ++index)
+                picked.push_back(generator.pickMove(index));
+            std::sort(moves.begin(), moves.end());
+            std::sort(picked.begin(), picked.end());
+            REQUIRE(picked == moves);
+            auto mv = generator.randomMove(numberGenerator);
+            REQUIRE(std::binary_search(moves.begin(), moves.end(), mv));
+            generator.applyMove(mv);
+        }
+
+        generator.setState({0, generateBitboard({20}), 0, 0, true, 0});
+        REQUIRE(generator.randomMove(numberGenerator) == 0);
+    }
+
+    SECTION("flip colours to position with the same moves")
+    {
+        REQUIRE(reverseBits(0x1) == 0x80000000);
+        REQUIRE(reverseBits(0x12345678) == 0x1E6A2C48);
+        CheckersMoveGenerator flipped;
+        for (int i = 0; i < 200; ++i)
+        {
+            auto state = generator.getState();
+            auto twin = flipColors(state);
+            auto back = flipColors(twin);
+            REQUIRE((back.white == state.white && back.black == state.black && back.kings == state.kings));
+            REQUIRE(back.whiteTurn == state.whiteTurn);
+            REQUIRE(canonicalState(state).whiteTurn == false);
+            flipped.setState(twin);
+            auto moves = generator.getMovesList();
+            std::vector<uint32_t> flippedMoves;
+            for (const auto mv : flipped.getMovesList())
+                flippedMoves.push_back(reverseBits(mv));
+            std::sort(moves.begin(), moves.end());
+            std::sort(flippedMoves.begin(), flippedMoves.end());
+            REQUIRE(flippedMoves == moves);
+            if (moves.empty())
+                break;
+            generator.applyMove(moves[(i * 7) % moves.size()]);
+        }
+    }
+
+    SECTION("share canonical hash between position and its flip")
+    {
+        CheckersMoveGenerator flipped;
+        generator.setCanonicalHash(true);
+        flipped.setCanonicalHash(true);
+        for (int i = 0; i < 200; ++i)
+        {
+            auto state = generator.getState();
+            flipped.setState(flipColors(state));
+            REQUIRE(generator.hash() == flipped.hash());
+            auto canonical = canonicalState(state);
+            REQUIRE(generator.hash() == zobristHash(canonical.white, canonical.black, canonical.kings, false));
+            auto moves = generator.getMovesList();
+            if (moves.empty())
+                break;
+            auto mv = moves[(i * 7) % moves.size()];
+            REQUIRE(flipped.canonicalMove(reverseBits(mv)) == generator.canonicalMove(mv));
+            auto expected = generator.hashAfter(mv);
+            auto undo = generator.applyMove(mv);
+            REQUIRE(generator.hash() == expected);
+            if (i % 3 == 0)
+            {
+                generator.undoMove(mv, undo);
+                REQUIRE(generator.hash() == flipped.hash());
+                generator.applyMove(mv);
+            }
+        }
+    }
+
+    SECTION("restore position hash with state")
+    {
+        auto init = generator.getState();
+        generator.applyMove(generator.getMovesList()[0]);
+        REQUIRE(generator.hash() != init.hash);
+        generator.setState(init);
+        REQUIRE(generator.hash() == init.hash);
+    }
+}
+
+TEST_CASE("Random generator should", "")
+{
+    SECTION("repeat sequence for the same seed and stay in range")
+    {
+        Xoshiro256 first(42), second(42);
+        for (uint32_t n = 1; n < 100; ++n)
+        {
+            auto value = first.range(n);
+            REQUIRE(value == second.range(n));
+            REQUIRE(value < n);
+        }
+    }
+}
+
+TEST_CASE("Batch playout should", "")
+{
+    SECTION("finish requested number of games and refill slots")
+    {
+        BatchPlayout engine(8, Xoshiro256(3));
+        auto stats = engine.run(50);
+        REQUIRE(stats.games == 50);
+        REQUIRE(stats.whiteWins + stats.blackWins + stats.draws == 50);
+        REQUIRE(stats.rounds > 50);
+    }
 }
 
+TEST_CASE("Search should", "")
+{
+    SECTION("find capture winning the game")
+    {
+        CheckersMoveGenerator generator;
+        gameState state{1u << 13, 1u << 17, 1u << 13, 0, true, 0};
+        generator.setState(state);
+        CheckersSearch search;
+        searchLimits limits;
+        limits.depth = 6;
+        auto result = search.search(generator, limits);
+        REQUIRE(result.bestMove == ((1u << 13) | (1u << 17) | (1u << 20)));
+        REQUIRE(result.score == winScore - 1);
+        REQUIRE(generator.hash() == zobristHash(state.white, state.black, state.kings, true));
+    }
+    SECTION("return legal move and keep position from start")
+    {
+        CheckersMoveGenerator generator;
+        auto before = generator.getState();
+        CheckersSearch search;
+        searchLimits limits;
+        limits.depth = 6;
+        auto result = search.search(generator, limits);
+        auto moves = generator.getMovesList();
+        REQUIRE(std::find(moves.begin(), moves.end(), result.bestMove) != moves.end());
+        REQUIRE(result.depth == 6);
+        REQUIRE(result.pv.size() >= 6);
+        auto after = generator.getState();
+        REQUIRE(after.white == before.white);
+        REQUIRE(after.black == before.black);
+        REQUIRE(after.hash == before.hash);
+    }
+}
+
+TEST_CASE("Transposition table should", "")
+{
+    TranspositionTable table(1);
+    tableStats stats;
+    tableEntry entry;
+    SECTION("return stored entry")
+    {
+        REQUIRE_FALSE(table.probe(0x1234567890ABCDEFULL, entry, stats));
+        table.store(0x1234567890ABCDEFULL, {0x00112233, -29990, 7, Bound::Lower}, stats);
+        REQUIRE(table.probe(0x1234567890ABCDEFULL, entry, stats));
+        REQUIRE(entry.move == 0x00112233);
+        REQUIRE(entry.score == -29990);
+        REQUIRE(entry.depth == 7);
+        REQUIRE(entry.bound == Bound::Lower);
+        REQUIRE_FALSE(table.probe(0x1234567890ABCDEEULL, entry, stats));
+        REQUIRE(stats.probes == 3);
+        REQUIRE(stats.hits == 1);
+    }
+    SECTION("replace shallowest entry of full bucket")
+    {
+        uint64_t bucketStride = table.size() / 64;
+        for (int i = 0; i < 4; ++i)
+            table.store(1 + i * bucketStride, {0, 0, 10 - i, Bound::Exact}, stats);
+        REQUIRE(stats.collisions == 0);
+        table.store(1 + 4 * bucketStride, {0, 0, 1, Bound::Exact}, stats);
+        REQUIRE(stats.collisions == 1);
+        REQUIRE(table.probe(1 + 4 * bucketStride, entry, stats));
+        REQUIRE_FALSE(table.probe(1 + 3 * bucketStride, entry, stats));
+        REQUIRE(table.probe(1, entry, stats));
+    }
+    SECTION("give search the same result")
+    {
+        CheckersMoveGenerator generator;
+        CheckersSearch search;
+        searchLimits limits;
+        limits.depth = 8;
+        auto plain = search.search(generator, limits);
+        search.setTable(&table);
+        auto hashed = search.search(generator, limits);
+        REQUIRE(hashed.score == plain.score);
+        REQUIRE(hashed.table.hits > 0);
+        REQUIRE(hashed.nodes < plain.nodes);
+    }
+}
+
+TEST_CASE("Parallel search should", "")
+{
+    SECTION("find capture winning the game with helpers")
+    {
+        CheckersMoveGenerator generator;
+        gameState state{1u << 13, 1u << 17, 1u << 13, 0, true, 0};
+        generator.setState(state);
+        TranspositionTable table(1);
+        ParallelSearch search(3);
+        searchLimits limits;
+        limits.depth = 6;
+        auto result = search.search(generator, limits, &table);
+        REQUIRE(result.bestMove == ((1u << 13) | (1u << 17) | (1u << 20)));
+        REQUIRE(result.score == winScore - 1);
+    }
+    SECTION("return legal move of main thread depth")
+    {
+        CheckersMoveGenerator generator;
+        TranspositionTable table(1);
+        ParallelSearch search(2);
+        searchLimits limits;
+        limits.depth = 7;
+        auto result = search.search(generator, limits, &table);
+        auto moves = generator.getMovesList();
+        REQUIRE(std::find(moves.begin(), moves.end(), result.bestMove) != moves.end());
+        REQUIRE(result.depth == 7);
+    }
+}
+
+TEST_CASE("Monte Carlo tree search should", "")
+{
+    CheckersMoveGenerator generator;
+    mctsLimits limits;
+    limits.playouts = 2000;
+    SECTION("visit one root move in every playout")
+    {
+        MctsSearch search(1, 100000);
+        auto result = search.search(generator, limits, Xoshiro256(5));
+        REQUIRE(result.playouts == 2000);
+        unsigned visits = 0;
+        for (const auto& child : result.rootVisits)
+            visits += child.second;
+        REQUIRE(visits == 2000);
+        REQUIRE(result.rootVisits.size() == 7);
+        auto moves = generator.getMovesList();
+        REQUIRE(std::find(moves.begin(), moves.end(), result.bestMove) != moves.end());
+    }
+    SECTION("run requested number of playouts on threads")
+    {
+        MctsSearch search(3, 100000);
+        auto result = search.search(generator, limits, Xoshiro256(5));
+        REQUIRE(result.playouts == 2000);
+        REQUIRE(result.rounds > 2000);
+    }
+    SECTION("keep playing out when node pool is exhausted")
+    {
+        MctsSearch search(1, 100);
+        auto result = search.search(generator, limits, Xoshiro256(5));
+        REQUIRE(result.playouts == 2000);
+        REQUIRE(result.nodes <= 100);
+    }
+    SECTION("prefer move winning the game")
+    {
+        gameState state{(1u << 13) | (1u << 0), 1u << 17, 1u << 13, 0, true, 0};
+        generator.setState(state);
+        MctsSearch search(1, 100000);
+        auto result = search.search(generator, limits, Xoshiro256(5));
+        REQUIRE(result.bestMove == ((1u << 13) | (1u << 17) | (1u << 20)));
+        REQUIRE(result.winRate == 1.0);
+    }
+}
+
+TEST_CASE("Tablebase should", "")
+{
+    static Tablebase tablebase;
+    if (tablebase.maxPieces() == 0)
+        tablebase.buildAll(3, 2);
+
+    SECTION("order slices after slices they depend on")
+    {
+        auto keys = Tablebase::slicesUpTo(3);
+        REQUIRE(keys.size() == 16);
+        REQUIRE(keys.front().pieces() == 2);
+        REQUIRE(keys.back().pieces() == 3);
+        REQUIRE(Tablebase::sliceSize({0, 1, 0, 1}) == 32 * 31 * 2);
+    }
+    SECTION("find win by capture of last piece")
+    {
+        auto value = tablebase.probe({1u << 13, 1u << 17, 1u << 13, 0, true, 0});
+        REQUIRE(value.result == TablebaseResult::Win);
+        REQUIRE(value.distance == 1);
+        // black man captures the king when black is to move
+        value = tablebase.probe({1u << 13, 1u << 17, 1u << 13, 0, false, 0});
+        REQUIRE(value.result == TablebaseResult::Win);
+        value = tablebase.probe({1u << 13, 1u << 21, 1u << 13, 0, false, 0});
+        REQUIRE(value.result != TablebaseResult::Win);
+    }
+    SECTION("win with two kings against one")
+    {
+        auto value = tablebase.probe({(1u << 0) | (1u << 1), 1u << 30, 0x40000003, 0, true, 0});
+        REQUIRE(value.result == TablebaseResult::Win);
+        REQUIRE(value.distance > 1);
+    }
+    SECTION("answer flipped positions from canonical slices")
+    {
+        Tablebase canonical;
+        canonical.setCanonical(true);
+        canonical.buildAll(3, 2);
+        REQUIRE(Tablebase::slicesUpTo(3, true).size() == 9);
+        Xoshiro256 numberGenerator(12);
+        int checked = 0;
+        while (checked < 2000)
+        {
+            uint32_t white = 1u << numberGenerator.range(32), black = 1u << numberGenerator.range(32);
+            uint32_t extra = 1u << numberGenerator.range(32);
+            if (popcount(white | black | extra) != 3)
+                continue;
+            gameState state{white | (numberGenerator.range(2) ? extra : 0), black, 0, 0, numberGenerator.range(2) == 0, 0};
+            state.black |= extra & ~state.white;
+            state.kings = (state.white | state.black) & static_cast<uint32_t>(numberGenerator());
+            if ((state.white & ~state.kings & 0xF0000000) || (state.black & ~state.kings & 0xF))
+                continue;
+            checked++;
+            auto expected = tablebase.probe(state);
+            for (const auto& position : {state, flipColors(state)})
+            {
+                auto value = canonical.probe(position);
+                REQUIRE(value.result == expected.result);
+                REQUIRE(value.distance == expected.distance);
+            }
+        }
+    }
+    SECTION("agree with values of positions after every move")
+    {
+        Xoshiro256 numberGenerator(11);
+        CheckersMoveGenerator generator;
+        int checked = 0;
+        while (checked < 2000)
+        {
+            uint32_t squares[3];
+            for (auto& square : squares)
+                square = 1u << numberGenerator.range(32);
+            if ((squares[0] | squares[1] | squares[2]) != (squares[0] ^ squares[1] ^ squares[2]))
+                continue;
+            gameState state{squares[0] | squares[1], squares[2], 0, 0, numberGenerator.range(2) == 0, 0};
+            state.kings = numberGenerator.range(8) & 7;
+            state.kings = (state.kings & 1 ? squares[0] : 0) | (state.kings & 2 ? squares[1] : 0) | (state.kings & 4 ? squares[2] : 0);
+            // men can't stand on their promotion row
+            if ((state.white & ~state.kings & 0xF0000000) || (state.black & ~state.kings & 0xF))
+                continue;
+            checked++;
+            auto value = tablebase.probe(state);
+            generator.setState(state);
+            MoveList moves;
+            generator.getMovesList(moves);
+            int bestWin = 1000, longestLoss = 0;
+            bool draw = false;
+            for (const auto mv : moves)
+            {
+                auto undo = generator.applyMove(mv);
+                auto child = tablebase.probe(generator.getState());
+                generator.undoMove(mv, undo);
+                if (child.result == TablebaseResult::Loss)
+                    bestWin = std::min(bestWin, child.distance + 1);
+                else if (child.result == TablebaseResult::Win)
+                    longestLoss = std::max(longestLoss, child.distance + 1);
+                else
+                    draw = true;
+            }
+            if (value.result == TablebaseResult::Win)
+                REQUIRE(value.distance == bestWin);
+            else if (value.result == TablebaseResult::Loss)
+                REQUIRE((bestWin == 1000 && !draw && value.distance == longestLoss));
+            else
+                REQUIRE((value.result == TablebaseResult::Draw && bestWin == 1000 && draw));
+        }
+    }
+}
@@ -1,27 +1,43 @@
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <iostream>
+#include <memory>
+#include <thread>
 #include <vector>
+#include <getopt.h>
 #include <moveGenerator.hpp>
+#include "perftTable.hpp"
 
 // generates results for all levels form depth to 1
+template <Color color>
 void perft_all(CheckersMoveGenerator &generator, std::vector<unsigned long> &result, int depth)
 {
-    auto moveList = generator.getMovesList();
-    result[depth-1] += moveList.size();
     if (depth == 1)
     {
+        result[0] += generator.countMoves<color>();
         return;
     }
+    MoveList moveList;
+    generator.getMovesList<color>(moveList);
+    result[depth-1] += moveList.size();
     depth--;
-    auto init = generator.getState();
     for (const auto& move : moveList)
     {
-        generator.applyMove(move);
-        perft_all(generator, result, depth);
-        generator.setState(init);
+        auto undo = generator.applyMove<color>(move);
+        perft_all<ColorTraits<color>::opponent>(generator, result, depth);
+        generator.undoMove<color>(move, undo);
     }
 }
 
+void perft_all(CheckersMoveGenerator &generator, std::vector<unsigned long> &result, int depth)
+{
+    if (generator.whiteTurn)
+        perft_all<Color::White>(generator, result, depth);
+    else
+        perft_all<Color::Black>(generator, result, depth);
+}
+
 // generates number of possible moves on given depth
 unsigned long perft(CheckersMoveGenerator &generator, int depth)
 {
@@ -29,32 +45,226 @@ unsigned long perft(CheckersMoveGenerator &generator, int depth)
     {
         return 1;
     }
+    if (depth == 1)
+    {
+        return generator.countMoves();
+    }
     unsigned long nodes = 0;
-    auto moveList = generator.getMovesList();
-    auto init = generator.getState();
+    MoveList moveList;
+    generator.getMovesList(moveList);
     for (const auto mv : moveList) 
     {
-        generator.applyMove(mv);
+        auto undo = generator.applyMove(mv);
         nodes += perft(generator, depth - 1);
-        generator.setState(init);
+        generator.undoMove(mv, undo);
     }
     return nodes;
 }
 
-int main()
+struct perftStats
 {
-    CheckersMoveGenerator generator;
-    int depth = 10;
-    std::cout << "depth: ";
-    std::cin >> depth;
-    
+    unsigned long probes = 0;
+    unsigned long hits = 0;
+};
+
+// perft with node counts of visited subtrees cached in table
+template <Color color>
+unsigned long perft_hashed(CheckersMoveGenerator &generator, PerftTable &table, perftStats &stats, int depth)
+{
+    if (depth == 0)
+    {
+        return 1;
+    }
+    if (depth == 1)
+    {
+        return generator.countMoves<color>();
+    }
+    unsigned long nodes = 0;
+    stats.probes++;
+    if (table.probe(generator.hash(), depth, nodes))
+    {
+        stats.hits++;
+        return nodes;
+    }
+    MoveList moveList;
+    generator.getMovesList<color>(moveList);
+    uint64_t hash = generator.hash();
+    for (const auto mv : moveList)
+    {
+        auto undo = generator.applyMove<color>(mv);
+        nodes += perft_hashed<ColorTraits<color>::opponent>(generator, table, stats, depth - 1);
+        generator.undoMove<color>(mv, undo);
+    }
+    table.store(hash, depth, nodes);
+    return nodes;
+}
+
+unsigned long perft_hashed(CheckersMoveGenerator &generator, PerftTable &table, perftStats &stats, int depth)
+{
+    if (generator.whiteTurn)
+        return perft_hashed<Color::White>(generator, table, stats, depth);
+    return perft_hashed<Color::Black>(generator, table, stats, depth);
+}
+
+// collects positions on split level and counts positions on levels above it
+void split_tree(CheckersMoveGenerator &generator, std::vector<gameState> &nodes, std::vector<unsigned long> &result, int level, int split)
+{
+    if (level == split)
+    {
+        nodes.push_back(generator.getState());
+        return;
+    }
+    MoveList moveList;
+    generator.getMovesList(moveList);
+    result[level] += moveList.size();
+    for (const auto mv : moveList)
+    {
+        auto undo = generator.applyMove(mv);
+        split_tree(generator, nodes, result, level + 1, split);
+        generator.undoMove(mv, undo);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int depth = 0;
+    int megabytes = 0;
+    int threads = 1;
+    int split = -1;
+    bool removeDuplicates = true;
+    bool canonical = false;
+    static const option longOptions[] = {
+        {"depth", required_argument, nullptr, 'd'},
+        {"hash", required_argument, nullptr, 'm'},
+        {"threads", required_argument, nullptr, 't'},
+        {"split", required_argument, nullptr, 's'},
+        {"keep-duplicates", no_argument, nullptr, 'k'},
+        {"canonical", no_argument, nullptr, 'f'},
+        {nullptr, 0, nullptr, 0}
+    };
+    int opt;
+    while ((opt = getopt_long(argc, argv, "d:m:t:s:kf", longOptions, nullptr)) != -1)
+    {
+        if (opt == 'd')
+        {
+            depth = atoi(optarg);
+        }
+        else if (opt == 'm')
+        {
+            megabytes = atoi(optarg);
+        }
+        else if (opt == 't')
+        {
+            threads = std::max(1, atoi(optarg));
+        }
+        else if (opt == 's')
+        {
+            split = atoi(optarg);
+        }
+        else if (opt == 'k')
+        {
+            removeDuplicates = false;
+        }
+        else if (opt == 'f')
+        {
+            canonical = true;
+        }
+    }
+    if (depth <= 0)
+    {
+        std::cout << "depth: ";
+        std::cin >> depth;
+    }
+    if (split < 0)
+    {
+        split = threads > 1 ? 4 : 0;
+    }
+    split = std::max(0, std::min(split, depth - 1));
+    int remaining = depth - split;
+
+    std::cout << "board: " << CheckersMoveGenerator::boardName() << std::endl;
+    std::unique_ptr<PerftTable> table;
+    if (megabytes > 0)
+    {
+        table.reset(new PerftTable(megabytes));
+        std::cout << "hash table: " << table->size() / (1024 * 1024) << " MB"
+                  << (canonical ? ", colour flipped positions shared" : "") << std::endl;
+    }
+
+    auto start = std::chrono::steady_clock::now();
     std::vector<unsigned long> result(depth, 0);
-    perft_all(generator, result, depth);
-    std::reverse(result.begin(), result.end());
+    std::vector<gameState> nodes;
+    CheckersMoveGenerator generator;
+    generator.setRemoveDuplicates(removeDuplicates);
+    split_tree(generator, nodes, result, 0, split);
+
+    // subtrees are handed out one by one to whichever thread is free
+    std::atomic<std::size_t> next(0);
+    std::vector<std::vector<unsigned long>> threadResults(threads, std::vector<unsigned long>(remaining, 0));
+    std::vector<perftStats> threadStats(threads);
+    auto worker = [&](int id)
+    {
+        CheckersMoveGenerator generator;
+        generator.setRemoveDuplicates(removeDuplicates);
+        generator.setCanonicalHash(canonical);
+        auto& counts = threadResults[id];
+        for (std::size_t i = next++; i < nodes.size(); i = next++)
+        {
+            generator.setState(nodes[i]);
+            if (table)
+            {
+                for (int d = 1; d <= remaining; ++d)
+                {
+                    counts[remaining - d] += perft_hashed(generator, *table, threadStats[id], d);
+                }
+            }
+            else
+            {
+                perft_all(generator, counts, remaining);
+            }
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int id = 1; id < threads; ++id)
+    {
+        pool.emplace_back(worker, id);
+    }
+    worker(0);
+    for (auto& thread : pool)
+    {
+        thread.join();
+    }
+
+    perftStats stats;
+    for (int id = 0; id < threads; ++id)
+    {
+        for (int k = 0; k < remaining; ++k)
+        {
+            result[depth - k - 1] += threadResults[id][k];
+        }
+        stats.probes += threadStats[id].probes;
+        stats.hits += threadStats[id].hits;
+    }
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000000.0;
+
+    unsigned long total = 0;
     for (int i = 0; i < depth; ++i)
     {
         std::cout << "depth " << i + 1 << " positions " << result[i] << std::endl;
+        total += result[i];
+    }
+    if (table)
+    {
+        std::cout << "hash hits: " << stats.hits << "/" << stats.probes
+                  << " (" << 100.0 * stats.hits / std::max(stats.probes, 1UL) << "%)" << std::endl;
+    }
+    if (threads > 1)
+    {
+        std::cout << "threads: " << threads << ", split depth: " << split << ", subtrees: " << nodes.size() << std::endl;
     }
+    std::cout << "time: " << seconds << "s" << std::endl;
+    std::cout << "nodes/s: " << total / seconds << std::endl;
 
     // std::cout << std::endl;
     // for (int i = 1; i <= depth; ++i)
@@ -62,4 +272,4 @@ int main()
     //     generator.resetState();
     //     std::cout << "depth " << i << " positions " << perft(generator, i) << std::endl;
     // }
-}
\ No newline at end of file
+}
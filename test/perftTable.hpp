@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+#include <locklessTable.hpp>
+
+// fixed-size cache of (position, side, depth) -> node count used by hashed perft
+// kept in LocklessTable under hash mixed with key of depth, so all 64 hash bits
+// are verified, depth key leaves low bits alone and all depths of one position
+// share bucket, depth is kept in high byte of stored count as well
+class PerftTable
+{
+public:
+    explicit PerftTable(std::size_t megabytes) : table(megabytes) {}
+
+    bool probe(uint64_t hash, int depth, unsigned long& nodes) const
+    {
+        uint64_t value;
+        if (!table.find(makeKey(hash, depth), value) || static_cast<int>(value >> 56) != depth)
+            return false;
+        nodes = value & countMask;
+        return true;
+    }
+
+    // replaces shallowest entry in bucket, empty subtrees are not cached
+    void store(uint64_t hash, int depth, unsigned long nodes)
+    {
+        table.store(makeKey(hash, depth), nodes | static_cast<uint64_t>(depth) << 56,
+                    [](uint64_t, uint64_t value) { return static_cast<int>(value >> 56); });
+    }
+
+    std::size_t size() const { return table.size(); }
+
+private:
+    static constexpr uint64_t countMask = (1ULL << 56) - 1;
+
+    static uint64_t makeKey(uint64_t hash, int depth)
+    {
+        return hash ^ (static_cast<uint64_t>(depth) * 0x9E3779B97F4A7C15ULL) << 32;
+    }
+
+    LocklessTable table;
+};